@@ -16,7 +16,7 @@ ee cmake --version
 ee mkdir -p contract/build
 ee pushd contract
 ee pushd build
-ee "cmake -DCMAKE_BUILD_TYPE=$DCMAKE_BUILD_TYPE -DWITH_TEST_ACTIONS=$DWITH_TEST_ACTIONS -DWITH_LARGE_STACK=$DWITH_TEST_ACTIONS .."
+ee "cmake -DCMAKE_BUILD_TYPE=$DCMAKE_BUILD_TYPE -DWITH_TEST_ACTIONS=$DWITH_TEST_ACTIONS -DWITH_LARGE_STACK=$DWITH_TEST_ACTIONS -DWITH_HOST_CRYPTO=${DWITH_HOST_CRYPTO:-off} .."
 ee make -j "$(nproc)"
 
 # pack
@@ -2,13 +2,20 @@
 #include "channels.hpp"
 #include "abi_utils.hpp"
 #include "utils.hpp"
+#include "block_entries.hpp"
 #include "contract_common/evm_common/block_mapping.hpp"
 
 #include <fstream>
+#include <future>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
 
 #include <silkworm/types/transaction.hpp>
 #include <silkworm/trie/vector_root.hpp>
+#include <silkworm/common/cast.hpp>
 #include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
 
 using sys = sys_plugin;
 
@@ -30,6 +37,56 @@ silkworm::log::BufferBase& operator << ( silkworm::log::BufferBase& ss, const si
    return ss;
 }
 
+struct decoded_transaction {
+   silkworm::Transaction tx;
+   silkworm::Bytes       encoded;   // value of the transaction in the transactions trie
+   evmc::bytes32         hash;
+   uint32_t              copied_bytes = 0;   // variable length fields copied out of the action payload by the decode
+};
+
+// Transactions of one pushtx or pushtxs action being decoded
+struct pending_action {
+   std::future<std::vector<decoded_transaction>> result;
+   uint32_t                                      native_block_num = 0;
+   uint32_t                                      action_index     = 0;
+};
+
+// Transactions trie leaves of the open EVM block, encoded as the transactions are appended so closing the block only
+// has to hash them.
+class transactions_root_builder {
+   public:
+      void absorb(silkworm::Bytes encoded) { leaves.emplace_back(std::move(encoded)); }
+      void pop() { leaves.pop_back(); }
+      void clear() { leaves.clear(); }
+      std::size_t size() const { return leaves.size(); }
+
+      // Rebuilds the leaves from scratch, used when an already closed block is reopened by a fork
+      void reset(const std::vector<silkworm::Transaction>& txs) {
+         leaves.clear();
+         for (const auto& tx : txs) absorb(encode(tx));
+      }
+
+      evmc::bytes32 root() const {
+         if (leaves.empty()) {
+            return silkworm::kEmptyRoot;
+         }
+
+         static constexpr auto kEncoder = [](silkworm::Bytes& to, const silkworm::Bytes& leaf) {
+            to.append(leaf);
+         };
+         return silkworm::trie::root_hash(leaves, kEncoder);
+      }
+
+      static silkworm::Bytes encode(const silkworm::Transaction& tx) {
+         silkworm::Bytes encoded;
+         silkworm::rlp::encode(encoded, tx, /*for_signing=*/false, /*wrap_eip2718_into_string=*/false);
+         return encoded;
+      }
+
+   private:
+      std::vector<silkworm::Bytes> leaves;
+};
+
 class block_conversion_plugin_impl : std::enable_shared_from_this<block_conversion_plugin_impl> {
    public:
       block_conversion_plugin_impl()
@@ -52,7 +109,13 @@ class block_conversion_plugin_impl : std::enable_shared_from_this<block_conversi
             return;
          }
          SILK_INFO << "load_head: " << *head_block;
-         evm_blocks.push_back(*head_block);
+         evm_block_entry head{std::make_shared<silkworm::Block>(*head_block), {}, true};
+         for (const auto& tx : head.block->transactions) {
+            auto encoded = transactions_root_builder::encode(tx);
+            head.refs.push_back({silkworm::bit_cast<evmc_bytes32>(silkworm::keccak256(encoded))});
+         }
+         transactions_root.reset(head.block->transactions);
+         evm_blocks.push_back(std::move(head));
 
          channels::native_block nb;
          std::optional<channels::native_block> start_from_block = appbase::app().get_plugin<ship_receiver_plugin>().get_start_from_block();
@@ -64,7 +127,6 @@ class block_conversion_plugin_impl : std::enable_shared_from_this<block_conversi
             nb.timestamp = head_block->header.timestamp*1e6;
          }
          SILK_INFO << "Loaded native block: [" << head_block->header.number << "][" << nb.block_num << "],[" << nb.timestamp << "]";
-         native_blocks.push_back(nb);
 
          auto genesis_header = appbase::app().get_plugin<engine_plugin>().get_genesis_header();
          if (!genesis_header) {
@@ -77,6 +139,8 @@ class block_conversion_plugin_impl : std::enable_shared_from_this<block_conversi
          SILK_INFO << "Block interval (in seconds): " << bm->block_interval;
          SILK_INFO << "Genesis timestamp (in seconds since Unix epoch): " << bm->genesis_timestamp;
 
+         push_native_block(std::make_shared<channels::native_block>(std::move(nb)));
+
          // The nonce in the genesis header encodes the name of the Antelope account on which the EVM contract has been deployed.
          // This name is necessary to determine which reserved address to use as the beneficiary of the blocks.
          evm_contract_name = silkworm::endian::load_big_u64(genesis_header->nonce.data());
@@ -95,29 +159,137 @@ class block_conversion_plugin_impl : std::enable_shared_from_this<block_conversi
          }
       }
 
-      evmc::bytes32 compute_transaction_root(const silkworm::BlockBody& body) {
-         if (body.transactions.empty()) {
-            return silkworm::kEmptyRoot;
+      decoded_transaction decode_transaction(silkworm::ByteView rlpx) const {
+         const auto rlpx_begin = rlpx;
+         decoded_transaction res;
+         if (silkworm::rlp::decode<silkworm::Transaction>(rlpx, res.tx) != silkworm::DecodingResult::kOk) {
+            throw std::runtime_error("Failed to decode transaction");
          }
+         res.encoded = transactions_root_builder::encode(res.tx);
+         res.hash = silkworm::bit_cast<evmc_bytes32>(silkworm::keccak256(rlpx_begin));
 
-         static constexpr auto kEncoder = [](silkworm::Bytes& to, const silkworm::Transaction& txn) {
-            silkworm::rlp::encode(to, txn, /*for_signing=*/false, /*wrap_eip2718_into_string=*/false);
-         };
+         // The scalar fields are parsed into integers, only the call data and the access list are copied as bytes
+         res.copied_bytes = res.tx.data.size();
+         for (const auto& entry : res.tx.access_list) {
+            res.copied_bytes += sizeof(entry.account) + entry.storage_keys.size() * sizeof(evmc::bytes32);
+         }
+         return res;
+      }
+
+      // Decodes the transaction of a pushtx action, or every transaction of a pushtxs action in order
+      std::vector<decoded_transaction> decode_action(const channels::native_action& act) const {
+         std::vector<decoded_transaction> res;
+         if (act.name != pushtxs_action) {
+            res.emplace_back(decode_transaction(pushtx_rlpx(act.data)));
+            return res;
+         }
+
+         eosio::input_stream d = act.data;
+         eosio::name miner;
+         uint32_t count;
+         eosio::from_bin(miner, d);
+         eosio::varuint32_from_bin(count, d);
+         res.reserve(count);
+         for (uint32_t i = 0; i < count; ++i) {
+            uint32_t size;
+            eosio::varuint32_from_bin(size, d);
+            if (d.remaining() < size) {
+               throw std::runtime_error("Invalid pushtxs action data");
+            }
+            res.emplace_back(decode_transaction({reinterpret_cast<const uint8_t*>(d.pos), size}));
+            d.skip(size);
+         }
+         return res;
+      }
+
+      // Decodes the transactions of `act` on the decode pool, or inline if there is none. The task holds `block`
+      // since the action payload points into its storage.
+      std::future<std::vector<decoded_transaction>> decode_async(std::shared_ptr<const channels::native_block> block,
+                                                                 const channels::native_action& act) {
+         auto task = std::make_shared<std::packaged_task<std::vector<decoded_transaction>()>>(
+            [this, block=std::move(block), act]() { return decode_action(act); });
+         auto res = task->get_future();
+         if (decode_pool) {
+            boost::asio::post(*decode_pool, [task]() { (*task)(); });
+         } else {
+            (*task)();
+         }
+         return res;
+      }
+
+      // Moves the transactions decoded so far into the last EVM block, in the order they were submitted
+      void resolve_pending_transactions() {
+         if (pending_actions.empty()) return;
+         auto& curr = evm_blocks.back();
+         for (auto& pending : pending_actions) {
+            std::vector<decoded_transaction> dtxs;
+            try {
+               dtxs = pending.result.get();
+            } catch (...) {
+               pending_actions.clear();
+               SILK_CRIT << "Failed to decode transaction in block: " << curr.block->header.number;
+               throw;
+            }
+            for (auto& dtx : dtxs) {
+               curr.block->transactions.emplace_back(std::move(dtx.tx));
+               curr.refs.push_back({dtx.hash, pending.native_block_num, pending.action_index});
+               transactions_root.absorb(std::move(dtx.encoded));
+               curr.copied_bytes += dtx.copied_bytes;
+            }
+         }
+         pending_actions.clear();
+      }
+
+      // Native blocks are stored along with the EVM block they map to, so it is computed once per block
+      void push_native_block(std::shared_ptr<const channels::native_block> block) {
+         const auto evm_num = timestamp_to_evm_block_num(block->timestamp);
+         native_blocks.push_back({without_payloads(std::move(block)), evm_num});
+      }
+
+      // Native blocks stay in the ring for the whole LIB window, while unwinds only walk their actions and never read
+      // the payloads again. The ring keeps a copy without them, so the SHiP message goes away with the decode tasks.
+      static std::shared_ptr<const channels::native_block> without_payloads(std::shared_ptr<const channels::native_block> block) {
+         if (!block->storage) return block;
+         auto copy = std::make_shared<channels::native_block>(*block);
+         for (auto& trx : copy->transactions) {
+            for (auto& act : trx.actions) act.data = {};
+         }
+         copy->storage.reset();
+         return copy;
+      }
 
-         evmc::bytes32 txn_root{silkworm::trie::root_hash(body.transactions, kEncoder)};
+      // Makes the last EVM block modifiable again after a fork, cloning it if its consumers may still read it
+      void reopen_last_evm_block() {
+         auto& last = evm_blocks.back();
+         if (!last.published) return;
+         last.block = std::make_shared<silkworm::Block>(*last.block);
+         last.published = false;
+      }
 
-         return txn_root;
+      void publish_evm_block(evm_block_entry& entry) {
+         entry.published = true;
+         evm_blocks_channel.publish(80, entry.block);
+
+         ++stats.blocks;
+         stats.transactions += entry.block->transactions.size();
+         stats.copied_bytes += entry.copied_bytes;
+         if (stats_interval && stats.blocks % stats_interval == 0) {
+            SILK_INFO << "Converted EVM blocks: " << stats.blocks << ", transactions: " << stats.transactions
+                      << ", transaction bytes copied per block: " << stats.copied_bytes / stats_interval
+                      << ", per transaction: " << (stats.transactions ? stats.copied_bytes / stats.transactions : 0);
+            stats = {};
+         }
       }
 
       void log_internal_status(const std::string& label) {
          SILK_INFO << "internal_status(" << label << "): nb:" << native_blocks.size() << ", evmb:" << evm_blocks.size();
       }
 
-      silkworm::Block generate_new_evm_block(uint64_t num, const evmc::bytes32& parent_hash) {
-         silkworm::Block new_block;
-         evm_common::prepare_block_header(new_block.header, bm.value(), evm_contract_name, num);
-         new_block.header.parent_hash       = parent_hash;
-         new_block.header.transactions_root = silkworm::kEmptyRoot;
+      std::shared_ptr<silkworm::Block> generate_new_evm_block(uint64_t num, const evmc::bytes32& parent_hash) {
+         auto new_block = std::make_shared<silkworm::Block>();
+         evm_common::prepare_block_header(new_block->header, bm.value(), evm_contract_name, num);
+         new_block->header.parent_hash       = parent_hash;
+         new_block->header.transactions_root = silkworm::kEmptyRoot;
          //new_block.header.mix_hash
          //new_block.header.nonce           
          //new_block.header.ommers_hash;
@@ -147,6 +319,12 @@ class block_conversion_plugin_impl : std::enable_shared_from_this<block_conversi
          }
       }
 
+      static uint32_t count_actions(const channels::native_block& block) {
+         uint32_t count = 0;
+         for(const auto& trx: block.transactions) count += trx.actions.size();
+         return count;
+      }
+
       template <typename F>
       void for_each_reverse_action(const channels::native_block& block, F&& f) {
          for(auto trx=block.transactions.rbegin(); trx != block.transactions.rend(); ++trx) {
@@ -162,170 +340,187 @@ class block_conversion_plugin_impl : std::enable_shared_from_this<block_conversi
          
          native_blocks_subscription = appbase::app().get_channel<channels::native_blocks>().subscribe(
             [this](auto new_block) {
-               static size_t count = 0;
-
                // Keep the last block before genesis timestamp
                if (new_block->timestamp <= bm.value().genesis_timestamp) {
                   SILK_WARN << "Before genesis: " << bm->genesis_timestamp <<  " Block #" << new_block->block_num << " timestamp: " << new_block->timestamp;
                   native_blocks.clear();
-                  native_blocks.push_back(*new_block);
+                  push_native_block(new_block);
                   return;
                }
 
                // Check if received native block can't be linked
-               if( !native_blocks.empty() && native_blocks.back().id != new_block->prev ) {
+               if( !native_blocks.empty() && native_blocks.back().block->id != new_block->prev ) {
 
                   SILK_WARN << "Can't link new block " << *new_block;
 
-                  // Find fork block
-                  auto fork_block = std::find_if(native_blocks.begin(), native_blocks.end(), [&new_block](const auto& nb){ return nb.id == new_block->prev; });
-                  if( fork_block == native_blocks.end() ) {
+                  // Find fork block, the blocks are consecutive so it can only be the one preceding the new block
+                  const auto* fork_block = native_blocks.find(new_block->block_num - 1);
+                  if( fork_block == nullptr || fork_block->block->id != new_block->prev ) {
                      SILK_CRIT << "Unable to find fork block " << new_block->prev;
                      throw std::runtime_error("Unable to find fork block");
                   }
 
-                  SILK_WARN << "Fork at Block " << *fork_block;
+                  SILK_WARN << "Fork at Block " << *fork_block->block;
+                  const auto fork_evm_num = fork_block->evm_block_num;
+                  resolve_pending_transactions();
 
                   // Remove EVM blocks after the fork
-                  while( !evm_blocks.empty() && timestamp_to_evm_block_num(fork_block->timestamp) < evm_blocks.back().header.number ) {
-                     SILK_WARN << "Removing forked EVM block " << evm_blocks.back();
+                  while( !evm_blocks.empty() && fork_evm_num < evm_blocks.back().block->header.number ) {
+                     SILK_WARN << "Removing forked EVM block " << *evm_blocks.back().block;
                      evm_blocks.pop_back();
                   }
+                  reopen_last_evm_block();
 
                   // Remove forked native blocks up until the fork point
-                  while( !native_blocks.empty() && native_blocks.back().id != fork_block->id ) {
+                  while( !native_blocks.empty() && native_blocks.back().block->block_num != new_block->block_num - 1 ) {
+                     const auto& forked = native_blocks.back();
 
                      // Check if the native block to be removed has transactions
                      // and they belong to the EVM block of the fork point
-                     if( native_blocks.back().transactions.size() > 0 && timestamp_to_evm_block_num(native_blocks.back().timestamp) == timestamp_to_evm_block_num(fork_block->timestamp) ) {
+                     if( forked.block->transactions.size() > 0 && forked.evm_block_num == fork_evm_num ) {
 
                         // Check that we can remove transactions contained in the forked native block
-                        if (evm_blocks.empty() || timestamp_to_evm_block_num(native_blocks.back().timestamp) != evm_blocks.back().header.number) {
+                        if (evm_blocks.empty() || forked.evm_block_num != evm_blocks.back().block->header.number) {
                            SILK_CRIT << "Unable to remove transactions"
                                        << "(empty: " << evm_blocks.empty()
-                                       << ", evmblock(native):" << timestamp_to_evm_block_num(native_blocks.back().timestamp) <<")"
-                                       << ", evm number:" << evm_blocks.back().header.number <<")";
+                                       << ", evmblock(native):" << forked.evm_block_num <<")"
+                                       << ", evm number:" << evm_blocks.back().block->header.number <<")";
                            throw std::runtime_error("Unable to remove transactions");
                         }
 
                         // Remove transactions in forked native block
-                        SILK_WARN << "Removing transactions in forked native block  " << native_blocks.back();
-                        for_each_reverse_action(native_blocks.back(), [this](const auto& act){
-                              auto dtx = deserialize_tx(act.data);
-                              auto txid_a = ethash::keccak256(dtx.rlpx.data(), dtx.rlpx.size());
-
-                              silkworm::Bytes transaction_rlp{};
-                              silkworm::rlp::encode(transaction_rlp, evm_blocks.back().transactions.back());
-                              auto txid_b = ethash::keccak256(transaction_rlp.data(), transaction_rlp.size());
-
-                              // Ensure that the transaction to be removed is the correct one
-                              if( std::memcmp(txid_a.bytes, txid_b.bytes, sizeof(txid_a.bytes)) != 0) {
-                                 SILK_CRIT << "Unable to remove transaction "
-                                             << ",txid_a:" << silkworm::to_hex(txid_a.bytes)
-                                             << ",txid_b:" << silkworm::to_hex(txid_b.bytes);
+                        SILK_WARN << "Removing transactions in forked native block  " << *forked.block;
+                        auto action_index = count_actions(*forked.block);
+                        for_each_reverse_action(*forked.block, [this, &forked, &action_index](const auto& act){
+                              --action_index;
+                              auto& evm_block = evm_blocks.back();
+
+                              // Ensure that the transactions to be removed are the ones appended for this action
+                              const bool removed = remove_action_transactions(evm_block, forked.block->block_num, action_index,
+                                 [](const evm_transaction_ref& ref) {
+                                    SILK_WARN << "Removing trx: " << silkworm::to_hex(ref.hash);
+                                 });
+                              if( !removed ) {
+                                 SILK_CRIT << "Unable to remove transaction for action " << action_index
+                                             << " of native block #" << forked.block->block_num
+                                             << (evm_block.refs.empty() ? std::string{} :
+                                                   ", last appended from #" + std::to_string(evm_block.refs.back().native_block_num) +
+                                                   " action " + std::to_string(evm_block.refs.back().action_index));
                                  throw std::runtime_error("Unable to remove transaction");
                               }
-
-                              SILK_WARN << "Removing trx: " << silkworm::to_hex(txid_a.bytes);
-                              evm_blocks.back().transactions.pop_back();
                         });
                      }
 
                      // Remove forked native block
-                     SILK_WARN << "Removing forked native block " << native_blocks.back();
+                     SILK_WARN << "Removing forked native block " << *forked.block;
                      native_blocks.pop_back();
                   }
 
                   // Ensure upper bound native block correspond to this EVM block
-                  if( evm_blocks.empty() || timestamp_to_evm_block_num(native_blocks.back().timestamp) != evm_blocks.back().header.number ) {
+                  if( evm_blocks.empty() || native_blocks.back().evm_block_num != evm_blocks.back().block->header.number ) {
                      SILK_CRIT << "Unable to set upper bound "
                                  << "(empty: " << evm_blocks.empty()
-                                 << ", evmblock(native):" << timestamp_to_evm_block_num(native_blocks.back().timestamp) <<")"
-                                 << ", evm number:" << evm_blocks.back().header.number <<")";
+                                 << ", evmblock(native):" << native_blocks.back().evm_block_num <<")"
+                                 << ", evm number:" << evm_blocks.back().block->header.number <<")";
                      throw std::runtime_error("Unable to set upper bound");
                   }
 
+                  // The EVM block may have been closed already, rebuild its trie leaves
+                  transactions_root.reset(evm_blocks.back().block->transactions);
+
                   // Reset upper bound
-                  SILK_WARN << "Reset upper bound for EVM Block " << evm_blocks.back() << " to: " << native_blocks.back();
-                  set_upper_bound(evm_blocks.back(), native_blocks.back());
+                  SILK_WARN << "Reset upper bound for EVM Block " << *evm_blocks.back().block << " to: " << *native_blocks.back().block;
+                  set_upper_bound(*evm_blocks.back().block, *native_blocks.back().block);
                }
 
                // Enqueue received block
-               native_blocks.push_back(*new_block);
+               push_native_block(new_block);
 
                // Extend the EVM chain if necessary up until the block where the received block belongs
-               auto evm_num = timestamp_to_evm_block_num(new_block->timestamp);
+               auto evm_num = native_blocks.back().evm_block_num;
 
-               while(evm_blocks.back().header.number < evm_num) {
-                  auto& last_evm_block = evm_blocks.back();
-                  last_evm_block.header.transactions_root = compute_transaction_root(last_evm_block);
-                  evm_blocks_channel.publish(80, std::make_shared<silkworm::Block>(last_evm_block));
-                  evm_blocks.push_back(generate_new_evm_block(last_evm_block.header.number+1, last_evm_block.header.hash()));
+               if(evm_blocks.back().block->header.number < evm_num) {
+                  resolve_pending_transactions();
                }
-
-               // Add transactions to the evm block
-               auto& curr = evm_blocks.back();
-               for_each_action(*new_block, [this, &curr](const auto& act){
-                     auto dtx = deserialize_tx(act.data);
-                     silkworm::ByteView bv = {(const uint8_t*)dtx.rlpx.data(), dtx.rlpx.size()};
-                     silkworm::Transaction evm_tx;
-                     if (silkworm::rlp::decode<silkworm::Transaction>(bv, evm_tx) != silkworm::DecodingResult::kOk) {
-                        SILK_CRIT << "Failed to decode transaction in block: " << curr.header.number;
-                        throw std::runtime_error("Failed to decode transaction");
-                     }
-                     curr.transactions.emplace_back(std::move(evm_tx));
-               });
-               set_upper_bound(curr, *new_block);
-
-               // Calculate last irreversible EVM block
-               std::optional<uint64_t> lib_timestamp;
-               auto it = std::upper_bound(native_blocks.begin(), native_blocks.end(), new_block->lib, [](uint32_t lib, const auto& nb) { return lib < nb.block_num; });
-               if(it != native_blocks.begin()) {
-                  --it;
-                  lib_timestamp = it->timestamp;
+               while(evm_blocks.back().block->header.number < evm_num) {
+                  auto& last = evm_blocks.back();
+                  last.block->header.transactions_root = transactions_root.root();
+                  publish_evm_block(last);
+                  const auto& header = last.block->header;
+                  evm_blocks.push_back({generate_new_evm_block(header.number+1, header.hash()), {}});
+                  transactions_root.clear();
                }
 
-               if( lib_timestamp ) {
-                  auto evm_lib = timestamp_to_evm_block_num(*lib_timestamp) - 1;
-
-                  // Remove irreversible native blocks
-                  while(timestamp_to_evm_block_num(native_blocks.front().timestamp) < evm_lib) {
-                     native_blocks.pop_front();
-                  }
+               // Queue the transactions of the evm block for decoding, they are collected when the block is closed
+               uint32_t action_index = 0;
+               for_each_action(*new_block, [this, &new_block, &action_index](const auto& act){
+                     pending_actions.push_back({decode_async(new_block, act), new_block->block_num, action_index++});
+               });
+               set_upper_bound(*evm_blocks.back().block, *new_block);
 
-                  // Remove irreversible evm blocks
-                  while(evm_blocks.front().header.number < evm_lib) {
-                     evm_blocks.pop_front();
-                  }
+               // Remove irreversible native and evm blocks
+               if( auto lib_evm_num = lib_evm_block_num(native_blocks, new_block->lib) ) {
+                  prune_irreversible(native_blocks, evm_blocks, *lib_evm_num);
                }
             }
          );
       }
 
-      inline pushtx deserialize_tx(const std::vector<char>& d) const {
-         pushtx tx;
-         eosio::convert_from_bin(tx, d);
-         return tx;
+      static constexpr eosio::name pushtxs_action = eosio::name("pushtxs");
+
+      // View of the `rlpx` field of a serialized pushtx, without copying it out of the action payload
+      static silkworm::ByteView pushtx_rlpx(eosio::input_stream d) {
+         eosio::name miner;
+         uint32_t size;
+         eosio::from_bin(miner, d);
+         eosio::varuint32_from_bin(size, d);
+         if (d.remaining() < size) {
+            throw std::runtime_error("Invalid pushtx action data");
+         }
+         return {reinterpret_cast<const uint8_t*>(d.pos), size};
+      }
+
+      void set_decode_threads(uint32_t threads) {
+         if (threads) decode_pool = std::make_unique<boost::asio::thread_pool>(threads);
       }
 
-      void shutdown() {}
+      void shutdown() {
+         if (decode_pool) decode_pool->join();
+      }
 
-      std::list<channels::native_block>             native_blocks;
-      std::list<silkworm::Block>                    evm_blocks;
+      native_block_ring                             native_blocks;
+      evm_block_ring                                evm_blocks;
       channels::evm_blocks::channel_type&           evm_blocks_channel;
       channels::native_blocks::channel_type::handle native_blocks_subscription;
       std::optional<evm_common::block_mapping>      bm;
       uint64_t                                      evm_contract_name = 0;
+      std::unique_ptr<boost::asio::thread_pool>     decode_pool;
+      std::vector<pending_action>                   pending_actions;
+      transactions_root_builder                     transactions_root;
+      uint32_t                                      stats_interval = 0;
+
+      struct {
+         uint64_t blocks       = 0;
+         uint64_t transactions = 0;
+         uint64_t copied_bytes = 0;
+      } stats;
 };
 
 block_conversion_plugin::block_conversion_plugin() : my(new block_conversion_plugin_impl()) {}
 block_conversion_plugin::~block_conversion_plugin() {}
 
 void block_conversion_plugin::set_program_options( appbase::options_description& cli, appbase::options_description& cfg ) {
-
+   cfg.add_options()
+      ("conversion-decode-threads", boost::program_options::value<uint32_t>()->default_value(2),
+        "number of threads decoding EVM transactions while their block is still open, 0 to decode them on the main thread")
+      ("conversion-stats-interval", boost::program_options::value<uint32_t>()->default_value(10000),
+        "log the transaction bytes copied per block every this many EVM blocks, 0 to disable")
+   ;
 }
 
 void block_conversion_plugin::plugin_initialize( const appbase::variables_map& options ) {
+   my->set_decode_threads(options.at("conversion-decode-threads").as<uint32_t>());
+   my->stats_interval = options.at("conversion-stats-interval").as<uint32_t>();
    my->init();
    SILK_INFO << "Initialized block_conversion Plugin";
 }
@@ -12,6 +12,14 @@ struct pushtx {
 };
 
 EOSIO_REFLECT(pushtx, miner, rlpx)
+
+struct pushtxs {
+   eosio::name                       miner;
+   std::vector<std::vector<uint8_t>> rlptxs;
+};
+
+EOSIO_REFLECT(pushtxs, miner, rlptxs)
+
 class block_conversion_plugin : public appbase::plugin<block_conversion_plugin> {
    public:
       APPBASE_PLUGIN_REQUIRES((sys_plugin)(ship_receiver_plugin)(engine_plugin));
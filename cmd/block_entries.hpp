@@ -0,0 +1,82 @@
+#pragma once
+
+#include "block_ring.hpp"
+#include "channels.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <silkworm/types/block.hpp>
+
+// Fork database of block_conversion_plugin: the native blocks of the LIB window and the EVM blocks they map to.
+
+// Blocks are shared with the channels rather than copied: native blocks are immutable once published and an EVM
+// block is only modified again after being published if a fork reopens it, in which case it is cloned first.
+struct native_block_entry {
+   std::shared_ptr<const channels::native_block> block;
+   uint32_t                                      evm_block_num = 0;
+};
+
+struct native_block_entry_num {
+   uint64_t operator()(const native_block_entry& e) const { return e.block->block_num; }
+};
+
+// Identity of an EVM transaction, cached when it is appended so fork unwinds don't have to re-encode it
+struct evm_transaction_ref {
+   evmc::bytes32 hash;
+   uint32_t      native_block_num = 0;
+   uint32_t      action_index     = 0;   // position of the pushtx(s) action within the native block
+};
+
+struct evm_block_entry {
+   std::shared_ptr<silkworm::Block> block;
+   std::vector<evm_transaction_ref> refs;   // one per transaction of the block
+   bool                             published = false;
+   uint64_t                         copied_bytes = 0;   // transaction bytes copied out of the SHiP messages by the decode
+};
+
+struct evm_block_entry_num {
+   uint64_t operator()(const evm_block_entry& e) const { return e.block->header.number; }
+};
+
+using native_block_ring = block_ring<native_block_entry, native_block_entry_num>;
+using evm_block_ring    = block_ring<evm_block_entry, evm_block_entry_num>;
+
+// Removes from `evm_block` the transactions appended for action `action_index` of native block `native_block_num`,
+// calling `on_remove` with the ref of each one first. Returns false, leaving the block untouched, when the last
+// transactions of the block were not appended for that action.
+template <typename F>
+bool remove_action_transactions(evm_block_entry& evm_block, uint32_t native_block_num, uint32_t action_index, F&& on_remove) {
+   auto appended_by_action = [&]() {
+      return !evm_block.refs.empty() && evm_block.refs.back().native_block_num == native_block_num &&
+             evm_block.refs.back().action_index == action_index;
+   };
+   if (!appended_by_action()) return false;
+   do {
+      on_remove(evm_block.refs.back());
+      evm_block.block->transactions.pop_back();
+      evm_block.refs.pop_back();
+   } while (appended_by_action());
+   return true;
+}
+
+// Last irreversible EVM block, i.e. the one of the newest native block not after `lib`, if the ring reaches back to it
+inline std::optional<uint32_t> lib_evm_block_num(const native_block_ring& native_blocks, uint32_t lib) {
+   if (native_blocks.empty() || native_blocks.front().block->block_num > lib) return {};
+   const auto idx = std::min<uint64_t>(lib - native_blocks.front().block->block_num, native_blocks.size() - 1);
+   return native_blocks[idx].evm_block_num;
+}
+
+// Removes the native and EVM blocks before the EVM block preceding `lib_evm_num`
+inline void prune_irreversible(native_block_ring& native_blocks, evm_block_ring& evm_blocks, uint32_t lib_evm_num) {
+   const auto evm_lib = lib_evm_num - 1;
+   while (native_blocks.front().evm_block_num < evm_lib) {
+      native_blocks.pop_front();
+   }
+   while (evm_blocks.front().block->header.number < evm_lib) {
+      evm_blocks.pop_front();
+   }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Contiguous ring buffer of consecutively numbered blocks.
+//
+// Blocks are appended at the back in increasing number order and removed from either end, so the element holding a
+// given block number is located with a subtraction instead of a scan. `Num` extracts the number of an element; the
+// buffer grows by doubling and never shrinks, so steady state operation does not allocate.
+template <typename T, typename Num>
+class block_ring {
+   public:
+      explicit block_ring(std::size_t initial_capacity = 1024, Num num = Num{}) : num_of(std::move(num)) {
+         std::size_t capacity = 1;
+         while (capacity < initial_capacity) capacity <<= 1;
+         slots.resize(capacity);
+      }
+
+      bool        empty() const { return count == 0; }
+      std::size_t size()  const { return count; }
+
+      T&       front()       { return slots[head]; }
+      const T& front() const { return slots[head]; }
+      T&       back()        { return slots[pos(count - 1)]; }
+      const T& back()  const { return slots[pos(count - 1)]; }
+
+      T&       operator[](std::size_t i)       { return slots[pos(i)]; }
+      const T& operator[](std::size_t i) const { return slots[pos(i)]; }
+
+      // Index of the element numbered `n`, if present
+      std::optional<std::size_t> index_of(uint64_t n) const {
+         if (empty()) return {};
+         const uint64_t first = num_of(front());
+         if (n < first || n - first >= count) return {};
+         return n - first;
+      }
+
+      T* find(uint64_t n) {
+         auto i = index_of(n);
+         return i ? &(*this)[*i] : nullptr;
+      }
+
+      void push_back(T value) {
+         if (!empty() && num_of(value) != num_of(back()) + 1) {
+            throw std::logic_error("block_ring: non consecutive block number " + std::to_string(num_of(value)) +
+                                   " after " + std::to_string(num_of(back())));
+         }
+         if (count == slots.size()) grow();
+         slots[pos(count)] = std::move(value);
+         ++count;
+      }
+
+      void pop_back() {
+         slots[pos(count - 1)] = T{};
+         --count;
+      }
+
+      void pop_front() {
+         slots[head] = T{};
+         head = (head + 1) & (slots.size() - 1);
+         --count;
+      }
+
+      void clear() {
+         while (!empty()) pop_back();
+         head = 0;
+      }
+
+   private:
+      std::size_t pos(std::size_t i) const { return (head + i) & (slots.size() - 1); }
+
+      void grow() {
+         std::vector<T> bigger(slots.size() * 2);
+         for (std::size_t i = 0; i < count; ++i) bigger[i] = std::move(slots[pos(i)]);
+         slots = std::move(bigger);
+         head = 0;
+      }
+
+      Num            num_of;
+      std::vector<T> slots;
+      std::size_t    head  = 0;
+      std::size_t    count = 0;
+};
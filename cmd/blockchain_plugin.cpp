@@ -1,10 +1,17 @@
 #include "blockchain_plugin.hpp"
 
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
+#include <boost/asio/steady_timer.hpp>
+
+#include <silkworm/db/stages.hpp>
 #include <silkworm/stagedsync/sync_loop.hpp>
 #include <silkworm/stagedsync/stage_direct_bodies.hpp>
 #include <silkworm/downloader/internals/header_persistence.hpp>
@@ -24,11 +31,19 @@ class blockchain_plugin_impl : std::enable_shared_from_this<blockchain_plugin_im
          sync_loop = std::make_unique<silkworm::stagedsync::SyncLoop>(node_settings, db_env, block_queue);
          sync_loop->start(/*wait=*/false);
 
+         flush_timer = std::make_unique<boost::asio::steady_timer>(appbase::app().get_io_service());
+         reset_stats();
+
          evm_blocks_subscription = appbase::app().get_channel<channels::evm_blocks>().subscribe(
             [this](auto b) {
                try {
                    //SILK_INFO << "EVM Block " << b->header.number;
-                   block_queue.push(b);
+                   if( is_catching_up(*b) ) {
+                       add_to_batch(std::move(b));
+                   } else {
+                       flush_batch();
+                       deliver({std::move(b)});
+                   }
 
                    if( sync_loop->get_state() == silkworm::Worker::State::kStopped ) {
                        appbase::app().quit();
@@ -44,7 +59,79 @@ class blockchain_plugin_impl : std::enable_shared_from_this<blockchain_plugin_im
          );
       }
 
+      // A block is part of a backlog when it is older than the catch up threshold
+      bool is_catching_up(const silkworm::Block& b) const {
+         if( max_batch_size <= 1 ) return false;
+         const auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+         return b.header.timestamp + catch_up_threshold < static_cast<uint64_t>(now);
+      }
+
+      // While catching up blocks are held back and queued together, so that a cycle of the sync loop starting after
+      // a flush finds the whole batch queued. This is best effort only: how many blocks a cycle commits in one RW
+      // transaction is decided by silkworm's sync loop, which may split or merge batches, and the stats merely observe
+      // it next to the batch size. The batch is flushed when full, when a block close to head arrives, or after
+      // max_batch_delay without new blocks.
+      void add_to_batch(std::shared_ptr<silkworm::Block> b) {
+         batch.emplace_back(std::move(b));
+         if( batch.size() >= max_batch_size ) {
+            flush_batch();
+            return;
+         }
+         if( batch.size() == 1 ) {
+            flush_timer->expires_after(max_batch_delay);
+            // A handler already queued when flush_batch cancels the timer still runs with success, the generation
+            // tells it the batch it was armed for is gone
+            flush_timer->async_wait([this, generation = batch_generation](const boost::system::error_code& ec) {
+               if( !ec && generation == batch_generation ) flush_batch();
+            });
+         }
+      }
+
+      void flush_batch() {
+         if( batch.empty() ) return;
+         flush_timer->cancel();
+         ++batch_generation;
+         deliver(std::move(batch));
+         batch.clear();
+      }
+
+      void deliver(std::vector<std::shared_ptr<silkworm::Block>> blocks) {
+         stats.batches++;
+         stats.blocks += blocks.size();
+         stats.max_batch = std::max<uint64_t>(stats.max_batch, blocks.size());
+         for( auto& b : blocks ) {
+            block_queue.push(std::move(b));
+         }
+
+         if( stats_interval.count() > 0 && std::chrono::steady_clock::now() - stats.since >= stats_interval ) {
+            // Every committed RW transaction bumps the txnid of the environment. This is an estimate of the blocks
+            // committed per cycle, exact only while the sync loop is the sole writer of the environment
+            const auto [txnid, executed] = read_commit_progress();
+            const auto commits = txnid - stats.txnid;
+            const auto committed = executed - stats.executed;
+            SILK_INFO << "EVM blocks queued: " << stats.blocks << " in " << stats.batches << " batches"
+                      << ", avg batch size: " << stats.blocks / stats.batches << ", max batch size: " << stats.max_batch
+                      << ", blocks executed: " << committed << " in " << commits << " commits"
+                      << ", avg blocks per commit: " << (commits ? committed / commits : 0);
+            reset_stats();
+         }
+      }
+
+      // Last committed txnid of the environment and execution stage progress
+      std::pair<uint64_t, silkworm::BlockNum> read_commit_progress() const {
+         const auto txnid = db_env->get_info().mi_recent_txnid;
+         auto txn = db_env->start_read();
+         return {txnid, silkworm::db::stages::read_stage_progress(txn, silkworm::db::stages::kExecutionKey)};
+      }
+
+      void reset_stats() {
+         stats = {};
+         std::tie(stats.txnid, stats.executed) = read_commit_progress();
+      }
+
       void shutdown() {
+         flush_timer->cancel();
+         flush_batch();
          sync_loop->stop(true);
       }
 
@@ -55,15 +142,47 @@ class blockchain_plugin_impl : std::enable_shared_from_this<blockchain_plugin_im
       channels::evm_blocks::channel_type::handle         evm_blocks_subscription;
       std::unique_ptr<silkworm::stagedsync::SyncLoop>    sync_loop;
       silkworm::stagedsync::DirectBodiesStage::BlockQueue block_queue;
+
+      std::vector<std::shared_ptr<silkworm::Block>>      batch;
+      std::unique_ptr<boost::asio::steady_timer>         flush_timer;
+      uint64_t                                           batch_generation = 0;
+      uint64_t                                           catch_up_threshold = 60;
+      std::size_t                                        max_batch_size = 1000;
+      std::chrono::milliseconds                          max_batch_delay{500};
+      std::chrono::seconds                               stats_interval{60};
+
+      struct {
+         uint64_t                              batches   = 0;
+         uint64_t                              blocks    = 0;
+         uint64_t                              max_batch = 0;
+         uint64_t                              txnid     = 0;
+         silkworm::BlockNum                    executed  = 0;
+         std::chrono::steady_clock::time_point since = std::chrono::steady_clock::now();
+      } stats;
 };
 
 blockchain_plugin::blockchain_plugin() : my(new blockchain_plugin_impl()) {}
 blockchain_plugin::~blockchain_plugin() {}
 
 void blockchain_plugin::set_program_options( appbase::options_description& cli, appbase::options_description& cfg ) {
+   cfg.add_options()
+      ("batch-catch-up-threshold", boost::program_options::value<uint64_t>()->default_value(60),
+        "EVM blocks older than this many seconds are batched before being handed to the sync loop. Best effort: the "
+        "sync loop still decides how many blocks each of its commits contains")
+      ("batch-max-blocks", boost::program_options::value<uint32_t>()->default_value(1000),
+        "maximum number of EVM blocks per batch while catching up, 1 disables batching")
+      ("batch-max-delay-ms", boost::program_options::value<uint32_t>()->default_value(500),
+        "maximum time an incomplete batch is held back")
+      ("batch-stats-interval", boost::program_options::value<uint32_t>()->default_value(60),
+        "seconds between reports of the number of blocks per batch and the estimated blocks per commit, 0 to disable")
+   ;
 }
 
 void blockchain_plugin::plugin_initialize( const appbase::variables_map& options ) {
+   my->catch_up_threshold = options.at("batch-catch-up-threshold").as<uint64_t>();
+   my->max_batch_size     = options.at("batch-max-blocks").as<uint32_t>();
+   my->max_batch_delay    = std::chrono::milliseconds(options.at("batch-max-delay-ms").as<uint32_t>());
+   my->stats_interval     = std::chrono::seconds(options.at("batch-stats-interval").as<uint32_t>());
    my->init();
    SILK_INFO << "Initialized Blockchain Plugin";
 }
@@ -17,7 +17,7 @@ namespace channels {
       eosio::name         receiver;
       eosio::name         account;
       eosio::name         name;
-      std::vector<char>   data;
+      eosio::input_stream data;   // borrowed from native_block::storage
    };
    
    struct native_trx {
@@ -39,8 +39,11 @@ namespace channels {
       int64_t                 timestamp = 0;
       uint32_t                lib = 0;
       std::vector<native_trx> transactions;
+      std::shared_ptr<const void> storage;   // keeps the memory referenced by the actions data alive
    };
    
-   using native_blocks = appbase::channel_decl<struct native_blocks_tag, std::shared_ptr<native_block>>;
+   // Blocks are handed over by shared pointer and never modified once published, so subscribers can keep them without
+   // copying. The action payloads of a native block still point into the SHiP message held by its `storage`.
+   using native_blocks = appbase::channel_decl<struct native_blocks_tag, std::shared_ptr<const native_block>>;
    using evm_blocks = appbase::channel_decl<struct evm_blocks_tag, std::shared_ptr<silkworm::Block>>;
 } // ns channels
\ No newline at end of file
@@ -0,0 +1,185 @@
+// Stress benchmark of the block_conversion_plugin fork database bookkeeping: linking, fork lookup and unwinding,
+// LIB calculation and pruning.
+//
+// Both sides consume the same stream of channels::native_block. The ring side keeps the plugin's own native and EVM
+// block rings (block_entries.hpp) and prunes them with the helpers the plugin calls. The fork walk and the extension of
+// the EVM chain are restated here without the transaction handling, decoding and publishing they are interleaved with
+// in the plugin. The list side is a model of the former std::list based scans, which no longer exist in the plugin.
+
+#include "block_entries.hpp"
+#include "contract_common/evm_common/block_mapping.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+using native_block_ptr = std::shared_ptr<const channels::native_block>;
+
+// EVM genesis in seconds; native blocks are 500ms apart, so two native blocks map to each 1s EVM block
+constexpr uint64_t genesis_timestamp = 10;
+
+// Block id carrying the block number like Antelope ids do, and the branch so that forked blocks differ
+eosio::checksum256 make_id(uint32_t block_num, uint32_t branch) {
+   std::array<uint8_t, 32> data{};
+   for (int i = 0; i < 4; ++i) {
+      data[i] = uint8_t(block_num >> (24 - 8 * i));
+      data[4 + i] = uint8_t(branch >> (24 - 8 * i));
+   }
+   return eosio::checksum256{data};
+}
+
+// Generates the block stream: every `fork_interval` blocks the chain switches to a new branch `fork_depth` blocks
+// deep. The LIB trails the head by `lib_lag` blocks.
+std::vector<native_block_ptr> make_stream(uint32_t num_blocks, uint32_t fork_interval, uint32_t fork_depth, uint32_t lib_lag) {
+   std::vector<native_block_ptr> stream;
+   std::vector<eosio::checksum256> ids(num_blocks + 2);
+   uint32_t branch = 0;
+   uint32_t head = 0;
+   while (head < num_blocks) {
+      if (fork_interval && head > fork_depth && !stream.empty() && stream.size() % fork_interval == 0) {
+         ++branch;
+         head -= fork_depth;
+      }
+      ++head;
+      auto b = std::make_shared<channels::native_block>(head, int64_t(genesis_timestamp * 1000000 + uint64_t(head) * 500000));
+      b->id   = make_id(head, branch);
+      b->prev = ids[head - 1];
+      b->lib  = head > lib_lag ? head - lib_lag : 0;
+      ids[head] = b->id;
+      stream.push_back(std::move(b));
+   }
+   return stream;
+}
+
+template <typename Impl>
+double run(const std::vector<native_block_ptr>& stream) {
+   Impl impl;
+   auto start = std::chrono::steady_clock::now();
+   for (const auto& b : stream) {
+      impl.apply(b);
+   }
+   return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / stream.size();
+}
+
+struct list_impl {
+   evm_common::block_mapping         bm{genesis_timestamp};
+   std::list<channels::native_block> native_blocks;
+   std::list<silkworm::Block>        evm_blocks;
+
+   void apply(const native_block_ptr& b) {
+      if (!native_blocks.empty() && native_blocks.back().id != b->prev) {
+         auto fork = std::find_if(native_blocks.begin(), native_blocks.end(), [&](const auto& nb) { return nb.id == b->prev; });
+         if (fork == native_blocks.end()) throw std::runtime_error("fork block not found");
+         const auto fork_evm_num = bm.timestamp_to_evm_block_num(fork->timestamp);
+         while (!evm_blocks.empty() && fork_evm_num < evm_blocks.back().header.number) evm_blocks.pop_back();
+         while (native_blocks.back().id != fork->id) {
+            (void)bm.timestamp_to_evm_block_num(native_blocks.back().timestamp);
+            native_blocks.pop_back();
+         }
+      }
+      native_blocks.push_back(*b);
+
+      const auto evm_num = bm.timestamp_to_evm_block_num(b->timestamp);
+      if (evm_blocks.empty()) {
+         evm_blocks.emplace_back().header.number = evm_num;
+      }
+      while (evm_blocks.back().header.number < evm_num) {
+         const auto number = evm_blocks.back().header.number + 1;
+         evm_blocks.emplace_back().header.number = number;
+      }
+
+      auto it = std::upper_bound(native_blocks.begin(), native_blocks.end(), b->lib, [](uint32_t l, const auto& nb) { return l < nb.block_num; });
+      if (it != native_blocks.begin()) {
+         --it;
+         auto evm_lib = bm.timestamp_to_evm_block_num(it->timestamp) - 1;
+         while (bm.timestamp_to_evm_block_num(native_blocks.front().timestamp) < evm_lib) native_blocks.pop_front();
+         while (evm_blocks.front().header.number < evm_lib) evm_blocks.pop_front();
+      }
+   }
+};
+
+struct ring_impl {
+   evm_common::block_mapping bm{genesis_timestamp};
+   native_block_ring         native_blocks;
+   evm_block_ring            evm_blocks;
+
+   static evm_block_entry make_evm_block(uint64_t number) {
+      auto block = std::make_shared<silkworm::Block>();
+      block->header.number = number;
+      return {std::move(block), {}};
+   }
+
+   void apply(const native_block_ptr& b) {
+      if (!native_blocks.empty() && native_blocks.back().block->id != b->prev) {
+         const auto* fork = native_blocks.find(b->block_num - 1);
+         if (fork == nullptr || fork->block->id != b->prev) throw std::runtime_error("fork block not found");
+         const auto fork_evm_num = fork->evm_block_num;
+         while (!evm_blocks.empty() && fork_evm_num < evm_blocks.back().block->header.number) evm_blocks.pop_back();
+         while (native_blocks.back().block->block_num != b->block_num - 1) native_blocks.pop_back();
+      }
+      const auto evm_num = bm.timestamp_to_evm_block_num(b->timestamp);
+      native_blocks.push_back({b, evm_num});
+
+      if (evm_blocks.empty()) {
+         evm_blocks.push_back(make_evm_block(evm_num));
+      }
+      while (evm_blocks.back().block->header.number < evm_num) {
+         evm_blocks.push_back(make_evm_block(evm_blocks.back().block->header.number + 1));
+      }
+
+      if (auto lib_evm_num = lib_evm_block_num(native_blocks, b->lib)) {
+         prune_irreversible(native_blocks, evm_blocks, *lib_evm_num);
+      }
+   }
+};
+
+int main(int argc, char* argv[]) {
+   po::options_description desc("Stress the native block fork database with deep forks and long unfinalized windows");
+   desc.add_options()
+      ("help", "print this help")
+      ("blocks", po::value<uint32_t>()->default_value(1000000), "number of blocks to apply")
+      ("fork-interval", po::value<uint32_t>()->default_value(1000), "blocks between forks, 0 disables forks")
+      ("fork-depth", po::value<std::vector<uint32_t>>()->multitoken()->default_value({1, 12, 100}, "1 12 100"),
+         "fork depths to measure")
+      ("lib-lag", po::value<std::vector<uint32_t>>()->multitoken()->default_value({2, 360, 1000}, "2 360 1000"),
+         "distance between head and LIB to measure")
+   ;
+
+   po::variables_map vm;
+   po::store(po::parse_command_line(argc, argv, desc), vm);
+   if (vm.count("help")) {
+      std::cout << desc << "\n";
+      return 0;
+   }
+   po::notify(vm);
+
+   const auto num_blocks = vm["blocks"].as<uint32_t>();
+   const auto fork_interval = vm["fork-interval"].as<uint32_t>();
+   try {
+      for (auto lib_lag : vm["lib-lag"].as<std::vector<uint32_t>>()) {
+         for (auto depth : vm["fork-depth"].as<std::vector<uint32_t>>()) {
+            if (depth >= lib_lag) continue;   // a fork can not go past the LIB
+            auto stream = make_stream(num_blocks, fork_interval, depth, lib_lag);
+            auto list_ns = run<list_impl>(stream);
+            auto ring_ns = run<ring_impl>(stream);
+            std::cout << "lib lag: " << lib_lag << " fork depth: " << depth
+                      << " list: " << list_ns << " ns/block"
+                      << " ring: " << ring_ns << " ns/block"
+                      << " speedup: " << (ring_ns > 0 ? list_ns / ring_ns : 0) << "x\n";
+         }
+      }
+   } catch (const std::exception& ex) {
+      std::cerr << "Error: " << ex.what() << "\n";
+      return -1;
+   }
+   return 0;
+}
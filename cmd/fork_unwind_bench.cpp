@@ -0,0 +1,147 @@
+// Measures the cost of removing the transactions of forked native blocks from the open EVM block, comparing the
+// former check (re-hash the pushtx RLP, re-encode and hash the EVM transaction) against the cached transaction refs
+// now kept by block_conversion_plugin.
+//
+// Both sides unwind the plugin's evm_block_entry. The cached side runs remove_action_transactions, the code the plugin
+// runs for each action of a forked native block. The rehash side is a model of the former check, which no longer
+// exists in the plugin; it starts from the pushtx payloads and so leaves out the action deserialization the former
+// code also paid for.
+
+#include "block_entries.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/types/transaction.hpp>
+
+namespace po = boost::program_options;
+
+// The part of a native block an unwind reads: its number and the rlpx of its pushtx actions
+struct bench_native_block {
+   uint32_t                     block_num = 0;
+   std::vector<silkworm::Bytes> rlpx;
+};
+
+silkworm::Transaction make_transaction(uint64_t nonce, std::size_t data_size) {
+   silkworm::Transaction tx;
+   tx.type = silkworm::Transaction::Type::kLegacy;
+   tx.nonce = nonce;
+   tx.max_priority_fee_per_gas = 150'000'000'000;
+   tx.max_fee_per_gas = 150'000'000'000;
+   tx.gas_limit = 1000000;
+   evmc::address to;
+   std::memset(to.bytes, 0xbb, sizeof(to.bytes));
+   tx.to = to;
+   tx.value = nonce;
+   tx.data = silkworm::Bytes(data_size, 0xab);
+   tx.odd_y_parity = false;
+   tx.chain_id = 15555;
+   tx.r = 1;
+   tx.s = 1;
+   return tx;
+}
+
+// Appends `native` blocks of `txs_per_block` transactions each to `evm`
+std::vector<bench_native_block> fill(evm_block_entry& evm, uint32_t native, uint32_t txs_per_block, std::size_t data_size) {
+   std::vector<bench_native_block> blocks(native);
+   uint64_t nonce = 0;
+   for (uint32_t b = 0; b < native; ++b) {
+      blocks[b].block_num = b + 1;
+      for (uint32_t i = 0; i < txs_per_block; ++i) {
+         auto tx = make_transaction(nonce++, data_size);
+         silkworm::Bytes rlpx;
+         silkworm::rlp::encode(rlpx, tx);
+         evm.refs.push_back({silkworm::bit_cast<evmc_bytes32>(silkworm::keccak256(rlpx)), blocks[b].block_num, i});
+         evm.block->transactions.push_back(std::move(tx));
+         blocks[b].rlpx.push_back(std::move(rlpx));
+      }
+   }
+   return blocks;
+}
+
+void unwind_rehash(evm_block_entry& evm, const std::vector<bench_native_block>& blocks) {
+   for (auto b = blocks.rbegin(); b != blocks.rend(); ++b) {
+      for (auto act = b->rlpx.rbegin(); act != b->rlpx.rend(); ++act) {
+         auto txid_a = silkworm::keccak256(*act);
+         silkworm::Bytes transaction_rlp{};
+         silkworm::rlp::encode(transaction_rlp, evm.block->transactions.back());
+         auto txid_b = silkworm::keccak256(transaction_rlp);
+         if (std::memcmp(txid_a.bytes, txid_b.bytes, sizeof(txid_a.bytes)) != 0) {
+            throw std::runtime_error("Unable to remove transaction");
+         }
+         evm.block->transactions.pop_back();
+      }
+   }
+}
+
+void unwind_cached(evm_block_entry& evm, const std::vector<bench_native_block>& blocks) {
+   for (auto b = blocks.rbegin(); b != blocks.rend(); ++b) {
+      for (uint32_t action_index = b->rlpx.size(); action_index-- > 0;) {
+         if (!remove_action_transactions(evm, b->block_num, action_index, [](const evm_transaction_ref&) {})) {
+            throw std::runtime_error("Unable to remove transaction");
+         }
+      }
+   }
+}
+
+template <typename Unwind>
+double measure(Unwind&& unwind, uint32_t native, uint32_t txs_per_block, std::size_t data_size, uint32_t iterations) {
+   double total = 0;
+   for (uint32_t i = 0; i < iterations; ++i) {
+      evm_block_entry evm{std::make_shared<silkworm::Block>(), {}};
+      auto blocks = fill(evm, native, txs_per_block, data_size);
+      auto start = std::chrono::steady_clock::now();
+      unwind(evm, blocks);
+      total += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+      if (!evm.block->transactions.empty()) throw std::runtime_error("Unwind left transactions behind");
+   }
+   return total / iterations;
+}
+
+int main(int argc, char* argv[]) {
+   po::options_description desc("Measure the removal of forked native block transactions from an EVM block");
+   desc.add_options()
+      ("help", "print this help")
+      ("depth", po::value<std::vector<uint32_t>>()->multitoken()->default_value({1, 10, 100}, "1 10 100"),
+         "number of forked native blocks to unwind")
+      ("txs-per-block", po::value<uint32_t>()->default_value(100), "EVM transactions per native block")
+      ("data-size", po::value<std::size_t>()->default_value(256), "calldata bytes per transaction")
+      ("iterations", po::value<uint32_t>()->default_value(20), "unwinds measured per depth")
+   ;
+
+   try {
+      po::variables_map vm;
+      po::store(po::parse_command_line(argc, argv, desc), vm);
+      if (vm.count("help")) {
+         std::cout << desc << "\n";
+         return 0;
+      }
+      po::notify(vm);
+
+      const auto txs = vm["txs-per-block"].as<uint32_t>();
+      const auto data_size = vm["data-size"].as<std::size_t>();
+      const auto iterations = std::max<uint32_t>(1, vm["iterations"].as<uint32_t>());
+      for (auto depth : vm["depth"].as<std::vector<uint32_t>>()) {
+         auto rehash_us = measure(unwind_rehash, depth, txs, data_size, iterations);
+         auto cached_us = measure(unwind_cached, depth, txs, data_size, iterations);
+         std::cout << "native blocks: " << depth << " txs: " << depth * txs
+                   << " rehash: " << rehash_us << " us"
+                   << " cached: " << cached_us << " us"
+                   << " speedup: " << (cached_us > 0 ? rehash_us / cached_us : 0) << "x\n";
+      }
+   } catch (const std::exception& ex) {
+      std::cerr << "Error: " << ex.what() << "\n";
+      return -1;
+   }
+   return 0;
+}
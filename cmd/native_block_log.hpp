@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <eosio/stream.hpp>
+#include <eosio/to_bin.hpp>
+#include <eosio/from_bin.hpp>
+
+#include <silkworm/common/log.hpp>
+
+#include "channels.hpp"
+
+// Append-only on-disk log of the filtered native blocks produced by ship_receiver_plugin.
+//
+// `native_blocks.log` holds one length prefixed entry per block (header fields plus the EVM actions only) and
+// `native_blocks.index` holds the 64 bit offset of every entry, preceded by the number of the first block, so any
+// block is found with a single index read. Blocks are expected in order; receiving a block number that is already in
+// the log (a fork) truncates the log back to it before appending.
+class native_block_log {
+   public:
+      explicit native_block_log(const std::filesystem::path& dir)
+         : log_path(dir / "native_blocks.log"), index_path(dir / "native_blocks.index") {
+         std::filesystem::create_directories(dir);
+         open();
+      }
+
+      std::optional<uint32_t> first_block_num() const {
+         if (empty()) return {};
+         return first_block;
+      }
+
+      std::optional<uint32_t> last_block_num() const {
+         if (empty()) return {};
+         return first_block + num_blocks - 1;
+      }
+
+      bool empty() const { return num_blocks == 0; }
+
+      void append(const channels::native_block& block) {
+         if (!empty()) {
+            if (block.block_num < first_block || block.block_num > *last_block_num() + 1) {
+               SILK_WARN << "Native block log does not contain block #" << block.block_num - 1 << ", restarting it";
+               reset();
+            } else if (block.block_num <= *last_block_num()) {
+               // A fork at the first logged block empties the log, the header is then written again below
+               truncate(block.block_num);
+            }
+         }
+         if (empty()) {
+            first_block = block.block_num;
+            index.seekp(0);
+            write_u64(index, first_block);
+         }
+
+         std::vector<char> entry;
+         eosio::vector_stream stream{entry};
+         serialize(block, stream);
+
+         uint64_t offset = log_size;
+         uint32_t size = entry.size();
+         log.seekp(offset);
+         log.write(reinterpret_cast<const char*>(&size), sizeof(size));
+         log.write(entry.data(), entry.size());
+         log_size += sizeof(size) + entry.size();
+
+         index.seekp(index_offset(num_blocks));
+         write_u64(index, offset);
+         ++num_blocks;
+      }
+
+      void flush() {
+         log.flush();
+         index.flush();
+      }
+
+      // Read-only view over a snapshot of the log, used to replay it. The mapping only lives as long as the reader:
+      // the tail of the log may be truncated by a fork later on, so blocks with actions get their own copy of the
+      // entry (EVM actions only, hence small) instead of borrowing from the mapping.
+      class reader {
+         public:
+            explicit reader(native_block_log& l) : log(l) {
+               log.flush();
+               if (log.log_size == 0) return;
+               auto file = boost::interprocess::file_mapping(log.log_path.c_str(), boost::interprocess::read_only);
+               region = boost::interprocess::mapped_region(file, boost::interprocess::read_only, 0, log.log_size);
+            }
+
+            std::shared_ptr<channels::native_block> read(uint32_t block_num) const {
+               if (log.empty() || block_num < log.first_block || block_num > *log.last_block_num()) return {};
+
+               const auto offset = log.read_offset(block_num - log.first_block);
+               const char* base = static_cast<const char*>(region.get_address()) + offset;
+               uint32_t size;
+               std::memcpy(&size, base, sizeof(size));
+               base += sizeof(size);
+
+               auto block = std::make_shared<channels::native_block>();
+               eosio::input_stream stream{base, base + size};
+               deserialize(*block, stream);
+               if (block->block_num != block_num) {
+                  throw std::runtime_error("Corrupted native block log at block #" + std::to_string(block_num));
+               }
+
+               if (!block->transactions.empty()) {
+                  auto entry = std::make_shared<std::vector<char>>(base, base + size);
+                  *block = channels::native_block{};
+                  eosio::input_stream owned{entry->data(), entry->data() + entry->size()};
+                  deserialize(*block, owned);
+                  block->storage = std::move(entry);
+               }
+               return block;
+            }
+
+         private:
+            native_block_log&                    log;
+            boost::interprocess::mapped_region   region;
+      };
+
+   private:
+      static constexpr uint64_t header_size = sizeof(uint64_t);
+
+      static uint64_t index_offset(uint64_t n) { return header_size + n * sizeof(uint64_t); }
+
+      static void write_u64(std::fstream& f, uint64_t v) {
+         f.write(reinterpret_cast<const char*>(&v), sizeof(v));
+      }
+
+      uint64_t read_offset(uint64_t n) {
+         uint64_t v = 0;
+         index.seekg(index_offset(n));
+         index.read(reinterpret_cast<char*>(&v), sizeof(v));
+         return v;
+      }
+
+      void open() {
+         for (const auto& p : {log_path, index_path}) {
+            if (!std::filesystem::exists(p)) std::ofstream{p, std::ios::binary};
+         }
+         log.open(log_path, std::ios::binary | std::ios::in | std::ios::out);
+         index.open(index_path, std::ios::binary | std::ios::in | std::ios::out);
+         if (!log.is_open() || !index.is_open()) {
+            throw std::runtime_error("Unable to open native block log at " + log_path.parent_path().string());
+         }
+
+         log_size = std::filesystem::file_size(log_path);
+         const auto index_size = std::filesystem::file_size(index_path);
+         if (index_size < index_offset(1)) {
+            reset();
+            return;
+         }
+
+         uint64_t first = 0;
+         index.seekg(0);
+         index.read(reinterpret_cast<char*>(&first), sizeof(first));
+         first_block = first;
+         num_blocks = (index_size - header_size) / sizeof(uint64_t);
+
+         // The two files are flushed independently, so after a crash several trailing index entries may point past
+         // the end of the log. Drop them, along with any partially written entry after the last complete one.
+         const auto indexed_blocks = num_blocks;
+         uint64_t end = 0;
+         for (; num_blocks > 0; --num_blocks) {
+            const auto offset = read_offset(num_blocks - 1);
+            uint32_t size = 0;
+            log.clear();
+            log.seekg(offset);
+            log.read(reinterpret_cast<char*>(&size), sizeof(size));
+            if (log && offset + sizeof(size) + size <= log_size) {
+               end = offset + sizeof(size) + size;
+               break;
+            }
+         }
+         log.clear();
+         index.clear();
+         if (num_blocks != indexed_blocks) {
+            SILK_WARN << "Dropping " << indexed_blocks - num_blocks << " incomplete entries at the end of the native block log";
+         }
+         if (end != log_size || num_blocks != indexed_blocks) {
+            log_size = end;
+            resize();
+         }
+         if (empty()) {
+            SILK_INFO << "Opened empty native block log";
+            return;
+         }
+
+         SILK_INFO << "Opened native block log with blocks [" << first_block << ", " << first_block + num_blocks - 1 << "]";
+      }
+
+      // Removes `block_num` and every block after it
+      void truncate(uint32_t block_num) {
+         const uint64_t n = block_num - first_block;
+         log_size = n ? read_offset(n) : 0;
+         num_blocks = n;
+         resize();
+      }
+
+      void reset() {
+         num_blocks = 0;
+         log_size = 0;
+         resize();
+      }
+
+      void resize() {
+         log.flush();
+         index.flush();
+         std::filesystem::resize_file(log_path, log_size);
+         std::filesystem::resize_file(index_path, num_blocks ? index_offset(num_blocks) : 0);
+      }
+
+      template <typename Stream>
+      static void serialize(const channels::native_block& block, Stream& s) {
+         eosio::to_bin(block.block_num, s);
+         eosio::to_bin(block.id, s);
+         eosio::to_bin(block.prev, s);
+         eosio::to_bin(block.timestamp, s);
+         eosio::to_bin(block.lib, s);
+         eosio::varuint32_to_bin(block.transactions.size(), s);
+         for (const auto& trx : block.transactions) {
+            eosio::to_bin(trx.id, s);
+            eosio::to_bin(trx.cpu_usage_us, s);
+            eosio::to_bin(trx.elapsed, s);
+            eosio::varuint32_to_bin(trx.actions.size(), s);
+            for (const auto& act : trx.actions) {
+               eosio::to_bin(act.ordinal, s);
+               eosio::to_bin(act.receiver, s);
+               eosio::to_bin(act.account, s);
+               eosio::to_bin(act.name, s);
+               eosio::varuint32_to_bin(act.data.remaining(), s);
+               s.write(act.data.pos, act.data.remaining());
+            }
+         }
+      }
+
+      static void deserialize(channels::native_block& block, eosio::input_stream& s) {
+         eosio::from_bin(block.block_num, s);
+         eosio::from_bin(block.id, s);
+         eosio::from_bin(block.prev, s);
+         eosio::from_bin(block.timestamp, s);
+         eosio::from_bin(block.lib, s);
+         uint32_t num_trxs;
+         eosio::varuint32_from_bin(num_trxs, s);
+         block.transactions.reserve(num_trxs);
+         for (uint32_t i = 0; i < num_trxs; ++i) {
+            eosio::checksum256 id;
+            uint32_t cpu_usage_us;
+            int64_t elapsed;
+            eosio::from_bin(id, s);
+            eosio::from_bin(cpu_usage_us, s);
+            eosio::from_bin(elapsed, s);
+            auto& trx = block.transactions.emplace_back(id, cpu_usage_us, elapsed);
+            uint32_t num_actions;
+            eosio::varuint32_from_bin(num_actions, s);
+            trx.actions.reserve(num_actions);
+            for (uint32_t j = 0; j < num_actions; ++j) {
+               auto& act = trx.actions.emplace_back();
+               eosio::from_bin(act.ordinal, s);
+               eosio::from_bin(act.receiver, s);
+               eosio::from_bin(act.account, s);
+               eosio::from_bin(act.name, s);
+               uint32_t size;
+               eosio::varuint32_from_bin(size, s);
+               act.data = eosio::input_stream{s.pos, s.pos + size};
+               s.skip(size);
+            }
+         }
+      }
+
+      std::filesystem::path log_path;
+      std::filesystem::path index_path;
+      std::fstream          log;
+      std::fstream          index;
+      uint64_t              log_size   = 0;
+      uint32_t              first_block = 0;
+      uint64_t              num_blocks  = 0;
+};
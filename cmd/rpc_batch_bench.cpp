@@ -0,0 +1,128 @@
+// Load benchmark of JSON-RPC batches against a running RPC daemon: over one keep-alive connection, compares sending N
+// requests one after the other with sending them as one batch of N.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using boost::asio::ip::tcp;
+
+class http_client {
+public:
+   http_client(boost::asio::io_context& io_context, const std::string& host, const std::string& port)
+      : socket_(io_context), host_(host) {
+      tcp::resolver resolver(io_context);
+      boost::asio::connect(socket_, resolver.resolve(host, port));
+      socket_.set_option(tcp::no_delay(true));
+   }
+
+   // Posts `body` and returns the body of the response
+   std::string post(const std::string& body) {
+      std::string request = "POST / HTTP/1.1\r\nHost: " + host_ +
+                            "\r\nContent-Type: application/json\r\nConnection: keep-alive\r\nContent-Length: " +
+                            std::to_string(body.size()) + "\r\n\r\n" + body;
+      boost::asio::write(socket_, boost::asio::buffer(request));
+
+      boost::asio::read_until(socket_, buffer_, "\r\n\r\n");
+      std::istream stream(&buffer_);
+      std::string line;
+      std::getline(stream, line);
+      if (line.find(" 200 ") == std::string::npos) throw std::runtime_error("unexpected status: " + line);
+      std::size_t content_length = 0;
+      while (std::getline(stream, line) && line != "\r") {
+         std::transform(line.begin(), line.end(), line.begin(), ::tolower);
+         if (line.rfind("content-length:", 0) == 0) content_length = std::stoul(line.substr(15));
+      }
+      if (buffer_.size() < content_length) {
+         boost::asio::read(socket_, buffer_, boost::asio::transfer_exactly(content_length - buffer_.size()));
+      }
+      std::string content(content_length, '\0');
+      stream.read(content.data(), content_length);
+      return content;
+   }
+
+private:
+   tcp::socket socket_;
+   std::string host_;
+   boost::asio::streambuf buffer_;
+};
+
+std::string make_request(const std::string& method, const std::string& params, std::size_t id) {
+   return "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id) + ",\"method\":\"" + method + "\",\"params\":" + params + "}";
+}
+
+int main(int argc, char* argv[]) {
+   po::options_description desc("Compare N single JSON-RPC requests with one batch of N over one connection");
+   desc.add_options()
+      ("help", "print this help")
+      ("host", po::value<std::string>()->default_value("127.0.0.1"), "RPC daemon host")
+      ("port", po::value<std::string>()->default_value("8881"), "RPC daemon port")
+      ("method", po::value<std::string>()->default_value("eth_blockNumber"), "method of every request")
+      ("params", po::value<std::string>()->default_value("[]"), "JSON params of every request")
+      ("batch-size", po::value<std::vector<std::size_t>>()->multitoken()->default_value({1, 10, 50, 100}, "1 10 50 100"),
+         "batch sizes to measure, at most the max batch size of the daemon")
+      ("rounds", po::value<uint32_t>()->default_value(100), "rounds measured per batch size")
+   ;
+
+   try {
+      po::variables_map vm;
+      po::store(po::parse_command_line(argc, argv, desc), vm);
+      if (vm.count("help")) {
+         std::cout << desc << "\n";
+         return 0;
+      }
+      po::notify(vm);
+
+      const auto method = vm["method"].as<std::string>();
+      const auto params = vm["params"].as<std::string>();
+      const auto rounds = std::max<uint32_t>(1, vm["rounds"].as<uint32_t>());
+
+      boost::asio::io_context io_context;
+      http_client client(io_context, vm["host"].as<std::string>(), vm["port"].as<std::string>());
+
+      for (auto size : vm["batch-size"].as<std::vector<std::size_t>>()) {
+         std::vector<std::string> requests;
+         std::string batch = "[";
+         for (std::size_t i = 0; i < size; ++i) {
+            requests.push_back(make_request(method, params, i));
+            batch += (i ? "," : "") + requests.back();
+         }
+         batch += "]";
+
+         auto start = std::chrono::steady_clock::now();
+         for (uint32_t r = 0; r < rounds; ++r) {
+            for (const auto& request : requests) client.post(request);
+         }
+         auto single_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+         start = std::chrono::steady_clock::now();
+         for (uint32_t r = 0; r < rounds; ++r) {
+            if (client.post(batch).front() != '[') throw std::runtime_error("batch rejected, check --batch-size");
+         }
+         auto batch_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+         const double requests_total = double(size) * rounds;
+         std::cout << "batch size: " << size
+                   << " single: " << requests_total / (single_ns / 1e9) << " req/s"
+                   << " batch: " << requests_total / (batch_ns / 1e9) << " req/s"
+                   << " speedup: " << (batch_ns > 0 ? single_ns / batch_ns : 0) << "x\n";
+      }
+   } catch (const std::exception& ex) {
+      std::cerr << "Error: " << ex.what() << "\n";
+      return -1;
+   }
+   return 0;
+}
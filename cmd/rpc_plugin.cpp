@@ -2,6 +2,7 @@
 
 #include <silkrpc/config.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -39,10 +40,20 @@ void rpc_plugin::set_program_options( appbase::options_description& cli, appbase
         "address to eos-evm-node of the form <address>:<port>")
       ("rpc-threads", boost::program_options::value<uint32_t>()->default_value(16),
         "number of threads for use with rpc")
+      ("rpc-contexts", boost::program_options::value<uint32_t>()->default_value(std::max(std::thread::hardware_concurrency() / 3, 1u)),
+        "number of I/O contexts (each one an asio and a gRPC thread) serving HTTP connections and database requests")
+      ("rpc-http-round-robin", boost::program_options::value<bool>()->default_value(false),
+        "accept HTTP connections on one context and run them on every context in turn, instead of one SO_REUSEPORT acceptor per context")
       ("chaindata", boost::program_options::value<std::string>()->default_value("./"),
         "directory of chaindata")
-      ("rpc-max-readers", boost::program_options::value<uint32_t>()->default_value(16),
+      ("rpc-max-readers", boost::program_options::value<uint32_t>()->default_value(silkrpc::kDefaultMaxReaders),
         "maximum number of rpc readers")
+      ("rpc-local-database", boost::program_options::value<bool>()->default_value(false),
+        "read chaindata directly from the MDBX database instead of through the KV interface of eos-evm-node (same host only)")
+      ("rpc-max-cursor-read-ahead", boost::program_options::value<uint32_t>()->default_value(silkrpc::kDefaultMaxCursorReadAhead),
+        "maximum number of records read ahead in one round trip by sequential KV cursors, 1 disables read-ahead")
+      ("rpc-max-batch-size", boost::program_options::value<uint32_t>()->default_value(silkrpc::kDefaultMaxBatchSize),
+        "maximum number of requests in a JSON RPC batch")
       ("api-spec", boost::program_options::value<std::string>()->default_value("eth"),
         "comma separated api spec, possible values: debug,engine,eth,net,parity,erigon,txpool,trace,web3")
       ("chain-id", boost::program_options::value<uint32_t>()->default_value(silkworm::kEOSEVMLocalTestnetConfig.chain_id),
@@ -117,16 +128,23 @@ void rpc_plugin::plugin_initialize( const appbase::variables_map& options ) try
    node_settings.chaindata_env_config.max_readers = max_readers;
    node_settings.chain_config = config;
 
+   // An empty chaindata makes silkrpc read the database through the KV interface of eos-evm-node
+   const bool local_database = options.at("rpc-local-database").as<bool>();
+
    silkrpc::DaemonSettings settings {
-      node_settings.data_directory->chaindata().path().string(),
+      local_database ? node_settings.data_directory->chaindata().path().string() : "",
       http_port,
       engine_port, 
       options.at("api-spec").as<std::string>() /* determine proper abi spec */,
       node_port,
-      std::thread::hardware_concurrency() / 3,
+      options.at("rpc-contexts").as<uint32_t>(),
       threads,
       log_level,
-      silkrpc::WaitMode::blocking
+      silkrpc::WaitMode::blocking,
+      options.at("rpc-max-batch-size").as<uint32_t>(),
+      options.at("rpc-http-round-robin").as<bool>(),
+      max_readers,
+      options.at("rpc-max-cursor-read-ahead").as<uint32_t>()
    };
 
    my.reset(new rpc_plugin_impl(settings));
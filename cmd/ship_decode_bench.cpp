@@ -0,0 +1,127 @@
+// Replays a SHiP stream recorded by eos-evm-node (see the `ship-record-file` option) through ship_decode_pipeline
+// and reports the decoding throughput in blocks/s.
+
+#include "ship_decoder.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using boost::beast::flat_buffer;
+
+std::vector<ship_decode_pipeline::buffer_ptr> load_recording(const std::string& path) {
+   std::ifstream in(path, std::ios::binary);
+   if (!in.is_open()) {
+      throw std::runtime_error("Unable to open recording " + path);
+   }
+
+   std::vector<ship_decode_pipeline::buffer_ptr> messages;
+   uint32_t size = 0;
+   while (in.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+      auto buff = std::make_shared<flat_buffer>();
+      auto dest = buff->prepare(size);
+      if (!in.read(static_cast<char*>(dest.data()), size)) {
+         throw std::runtime_error("Truncated recording " + path);
+      }
+      buff->commit(size);
+      messages.emplace_back(std::move(buff));
+   }
+   return messages;
+}
+
+struct bench_result {
+   std::size_t blocks  = 0;
+   std::size_t actions = 0;
+   double      seconds = 0;
+};
+
+bench_result run(const ship_block_decoder& decoder, const std::vector<ship_decode_pipeline::buffer_ptr>& messages,
+                 uint32_t threads, uint32_t max_in_flight) {
+   ship_decode_pipeline pipeline(decoder, threads, max_in_flight);
+   std::mutex mtx;
+   std::condition_variable cv;
+   bool notified = false;
+
+   bench_result res;
+   uint32_t prev_block_num = 0;
+   auto publish = [&](auto block) {
+      if (prev_block_num && block->block_num != prev_block_num + 1) {
+         throw std::runtime_error("Out of order block #" + std::to_string(block->block_num));
+      }
+      prev_block_num = block->block_num;
+      for (const auto& trx : block->transactions) res.actions += trx.actions.size();
+      ++res.blocks;
+   };
+
+   auto start = std::chrono::steady_clock::now();
+   std::size_t next = 0;
+   while (res.blocks < messages.size()) {
+      while (next < messages.size() && !pipeline.full()) {
+         pipeline.submit(messages[next++], [&]() {
+            std::lock_guard lock(mtx);
+            notified = true;
+            cv.notify_one();
+         });
+      }
+      if (pipeline.drain(publish) == 0) {
+         std::unique_lock lock(mtx);
+         cv.wait(lock, [&]() { return notified; });
+         notified = false;
+      }
+   }
+   res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   return res;
+}
+
+int main(int argc, char* argv[]) {
+   po::options_description desc("Replay a recorded SHiP stream through the EOS EVM native block decoder");
+   desc.add_options()
+      ("help", "print this help")
+      ("recording", po::value<std::string>()->required(), "file written by eos-evm-node ship-record-file")
+      ("core-account", po::value<std::string>()->default_value("evmevmevmevm"), "account hosting the EVM contract")
+      ("threads", po::value<std::vector<uint32_t>>()->multitoken()->default_value({0, 1, 2, 4, 8}, "0 1 2 4 8"),
+         "decode thread counts to measure")
+      ("max-blocks-in-flight", po::value<uint32_t>()->default_value(256), "decode window size")
+      ("repeat", po::value<uint32_t>()->default_value(3), "runs per thread count, the best one is reported")
+   ;
+
+   try {
+      po::variables_map vm;
+      po::store(po::parse_command_line(argc, argv, desc), vm);
+      if (vm.count("help")) {
+         std::cout << desc << "\n";
+         return 0;
+      }
+      po::notify(vm);
+
+      const auto messages = load_recording(vm["recording"].as<std::string>());
+      const ship_block_decoder decoder{eosio::name(vm["core-account"].as<std::string>())};
+      const auto window = vm["max-blocks-in-flight"].as<uint32_t>();
+      const auto repeat = std::max<uint32_t>(1, vm["repeat"].as<uint32_t>());
+      std::cout << "Loaded " << messages.size() << " SHiP messages\n";
+
+      for (auto threads : vm["threads"].as<std::vector<uint32_t>>()) {
+         bench_result best;
+         for (uint32_t i = 0; i < repeat; ++i) {
+            auto res = run(decoder, messages, threads, window);
+            if (best.seconds == 0 || res.seconds < best.seconds) best = res;
+         }
+         std::cout << "threads: " << threads
+                   << " blocks: " << best.blocks
+                   << " evm actions: " << best.actions
+                   << " time: " << best.seconds << "s"
+                   << " blocks/s: " << (best.seconds > 0 ? best.blocks / best.seconds : 0) << "\n";
+      }
+   } catch (const std::exception& ex) {
+      std::cerr << "Error: " << ex.what() << "\n";
+      return -1;
+   }
+   return 0;
+}
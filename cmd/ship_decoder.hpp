@@ -0,0 +1,310 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+
+#include <eosio/ship_protocol.hpp>
+
+#include "channels.hpp"
+
+// Converts raw SHiP `get_blocks_result_v0` messages into `channels::native_block`s.
+// The decoder is stateless once constructed so a single instance can be shared by several worker threads.
+class ship_block_decoder {
+   public:
+      using native_block_t = channels::native_block;
+      static constexpr eosio::name pushtx = eosio::name("pushtx");
+      static constexpr eosio::name pushtxs = eosio::name("pushtxs");
+
+      explicit ship_block_decoder(eosio::name ca = {}) : core_account(ca) {}
+
+      template <typename Buffer>
+      eosio::ship_protocol::result get_result(Buffer&& b) const {
+         auto data = b->data();
+         eosio::input_stream bin = {(const char*)data.data(), (const char*)data.data() + data.size()};
+         return eosio::from_bin<eosio::ship_protocol::result>(bin);
+      }
+
+      template <typename Buffer>
+      std::optional<native_block_t> decode(Buffer&& b) const {
+         auto block = to_native(std::get<eosio::ship_protocol::get_blocks_result_v0>(get_result(b)));
+         // Action payloads point into the message, keep it alive for as long as the block references it
+         if (block && !block->transactions.empty()) block->storage = b;
+         return block;
+      }
+
+      template <typename T>
+      std::optional<native_block_t> to_native(T&& block) const {
+
+         // Without a block there is nothing to convert, decode_one reports it as an error
+         if (!block.this_block) {
+            return std::nullopt;
+         }
+
+         auto current_block = start_native_block(block);
+
+         if (block.traces) {
+            // Walk the raw traces instead of deserializing every transaction_trace; only the actions sent to the
+            // EVM contract are materialized and their payload is borrowed from the message buffer.
+            eosio::input_stream traces = *block.traces;
+            uint32_t num;
+            eosio::varuint32_from_bin(num, traces);
+            for (std::size_t i = 0; i < num; i++) {
+               scan_transaction_trace(traces, &current_block);
+            }
+         }
+
+         current_block.lib = block.last_irreversible.block_num;
+         return std::optional<native_block_t>(std::move(current_block));
+      }
+
+      template <typename BlockResult>
+      inline native_block_t start_native_block(BlockResult&& res) const {
+         native_block_t block;
+         if (!res.block) {
+            throw std::runtime_error("SHiP result without block for #" + std::to_string(res.this_block->block_num));
+         }
+
+         // The timestamp is the leading field of the signed block header and the only one we use, read it directly
+         // instead of deserializing the whole signed_block with all its packed transactions.
+         eosio::input_stream header = *res.block;
+         eosio::block_timestamp timestamp;
+         eosio::from_bin(timestamp, header);
+
+         block.block_num = res.this_block->block_num;
+         block.id        = res.this_block->block_id;
+         block.prev      = res.prev_block->block_id;
+         block.timestamp = timestamp.to_time_point().time_since_epoch().count();
+         return block;
+      }
+
+      // Reads one transaction_trace from `s` appending it to `block` if it contains pushtx(s) actions for the core
+      // account. Passing a null `block` just skips the trace.
+      void scan_transaction_trace(eosio::input_stream& s, native_block_t* block) const {
+         check_variant(s, 0, "transaction_trace");
+
+         eosio::checksum256 id;
+         uint32_t cpu_usage_us = 0;
+         int64_t elapsed = 0;
+         eosio::from_bin(id, s);
+         s.skip(1);                                // status
+         eosio::from_bin(cpu_usage_us, s);
+         skip_varuint32(s);                        // net_usage_words
+         eosio::from_bin(elapsed, s);
+         s.skip(sizeof(uint64_t) + 1);             // net_usage, scheduled
+
+         channels::native_trx native_trx = {id, cpu_usage_us, elapsed};
+         uint32_t num_actions;
+         eosio::varuint32_from_bin(num_actions, s);
+         for (uint32_t j = 0; j < num_actions; ++j) {
+            scan_action_trace(s, block ? &native_trx : nullptr);
+         }
+
+         if (read_bool(s)) s.skip(sizeof(uint64_t) + sizeof(int64_t));   // account_ram_delta
+         if (read_bool(s)) skip_bytes(s);                                   // except
+         if (read_bool(s)) s.skip(sizeof(uint64_t));                        // error_code
+
+         uint32_t num_failed;
+         eosio::varuint32_from_bin(num_failed, s);
+         for (uint32_t j = 0; j < num_failed; ++j) {
+            scan_transaction_trace(s, nullptr);   // failed_dtrx_trace
+         }
+
+         // Rarely present, fall back to the regular deserializer
+         std::optional<eosio::ship_protocol::partial_transaction> partial;
+         eosio::from_bin(partial, s);
+
+         if (block && !native_trx.actions.empty()) {
+            block->transactions.emplace_back(std::move(native_trx));
+         }
+      }
+
+   private:
+      void scan_action_trace(eosio::input_stream& s, channels::native_trx* trx) const {
+         uint32_t version = check_variant(s, 1, "action_trace");
+
+         uint32_t ordinal;
+         eosio::varuint32_from_bin(ordinal, s);
+         skip_varuint32(s);                        // creator_action_ordinal
+         if (read_bool(s)) {                       // receipt
+            check_variant(s, 0, "action_receipt");
+            s.skip(sizeof(uint64_t) + 32 + 2*sizeof(uint64_t));   // receiver, act_digest, global/recv sequence
+            skip_vector(s, 2*sizeof(uint64_t));                     // auth_sequence
+            skip_varuint32(s);                                      // code_sequence
+            skip_varuint32(s);                                      // abi_sequence
+         }
+
+         eosio::name receiver, account, name;
+         eosio::from_bin(receiver, s);
+         eosio::from_bin(account, s);
+         eosio::from_bin(name, s);
+         skip_vector(s, 2*sizeof(uint64_t));      // authorization
+         uint32_t size;
+         eosio::varuint32_from_bin(size, s);
+         eosio::input_stream data{s.pos, s.pos + size};
+         s.skip(size);
+
+         s.skip(1 + sizeof(int64_t));              // context_free, elapsed
+         skip_bytes(s);                            // console
+         skip_vector(s, sizeof(uint64_t) + sizeof(int64_t));   // account_ram_deltas
+         if (read_bool(s)) skip_bytes(s);          // except
+         if (read_bool(s)) s.skip(sizeof(uint64_t));   // error_code
+         if (version == 1) skip_bytes(s);          // return_value
+
+         if (trx && (name == pushtx || name == pushtxs) && core_account == receiver) {
+            trx->actions.emplace_back(channels::native_action{ordinal, receiver, account, name, data});
+         }
+      }
+
+      static uint32_t check_variant(eosio::input_stream& s, uint32_t max_index, const char* type) {
+         uint32_t index;
+         eosio::varuint32_from_bin(index, s);
+         if (index > max_index) {
+            throw std::runtime_error(std::string("Unsupported ") + type + " variant " + std::to_string(index));
+         }
+         return index;
+      }
+
+      static bool read_bool(eosio::input_stream& s) {
+         bool value;
+         eosio::from_bin(value, s);
+         return value;
+      }
+
+      static void skip_varuint32(eosio::input_stream& s) {
+         uint32_t ignored;
+         eosio::varuint32_from_bin(ignored, s);
+      }
+
+      static void skip_bytes(eosio::input_stream& s) {
+         uint32_t size;
+         eosio::varuint32_from_bin(size, s);
+         s.skip(size);
+      }
+
+      static void skip_vector(eosio::input_stream& s, std::size_t element_size) {
+         uint32_t size;
+         eosio::varuint32_from_bin(size, s);
+         s.skip(size * element_size);
+      }
+
+      eosio::name core_account;
+};
+
+// Decodes SHiP block messages on a worker pool while handing the results back in submission order.
+//
+// `submit` is called from the reader with each raw message as it arrives; decoding runs on one of the pool threads
+// and `on_ready` is invoked (from that worker thread) once the result is stored. The owner is then expected to call
+// `drain` from its own thread, which yields every block whose predecessors have all been decoded. With zero threads
+// the message is decoded inline by `submit`, matching the original serial behavior.
+class ship_decode_pipeline {
+   public:
+      using buffer_ptr = std::shared_ptr<boost::beast::flat_buffer>;
+      using block_ptr  = std::shared_ptr<channels::native_block>;
+
+      ship_decode_pipeline(const ship_block_decoder& decoder, std::size_t threads, std::size_t max_in_flight)
+         : decoder(decoder), max_in_flight(max_in_flight == 0 ? 1 : max_in_flight) {
+         if (threads)
+            pool = std::make_unique<boost::asio::thread_pool>(threads);
+      }
+
+      ~ship_decode_pipeline() {
+         stop();
+      }
+
+      void stop() {
+         if (pool) {
+            pool->join();
+            pool.reset();
+         }
+      }
+
+      // Whether the reader should pause until `drain` has released some blocks
+      bool full() const {
+         std::lock_guard lock(mtx);
+         return next_seq - next_publish >= max_in_flight;
+      }
+
+      std::size_t in_flight() const {
+         std::lock_guard lock(mtx);
+         return next_seq - next_publish;
+      }
+
+      template <typename F>
+      void submit(buffer_ptr buff, F&& on_ready) {
+         uint64_t seq;
+         {
+            std::lock_guard lock(mtx);
+            seq = next_seq++;
+         }
+
+         if (!pool) {
+            decode_one(seq, std::move(buff));
+            on_ready();
+            return;
+         }
+
+         boost::asio::post(*pool, [this, seq, buff=std::move(buff), on_ready=std::forward<F>(on_ready)]() mutable {
+            decode_one(seq, std::move(buff));
+            on_ready();
+         });
+      }
+
+      // Hands every contiguous decoded block to `publish` in submission order. Rethrows the decoding error of the
+      // first failed message, if any.
+      template <typename F>
+      std::size_t drain(F&& publish) {
+         std::size_t count = 0;
+         while (true) {
+            entry e;
+            {
+               std::lock_guard lock(mtx);
+               auto it = ready.find(next_publish);
+               if (it == ready.end()) break;
+               e = std::move(it->second);
+               ready.erase(it);
+               ++next_publish;
+            }
+            if (e.error) std::rethrow_exception(e.error);
+            publish(std::move(e.block));
+            ++count;
+         }
+         return count;
+      }
+
+   private:
+      struct entry {
+         block_ptr          block;
+         std::exception_ptr error;
+      };
+
+      void decode_one(uint64_t seq, buffer_ptr buff) {
+         entry e;
+         try {
+            auto block = decoder.decode(buff);
+            if (!block) throw std::runtime_error("Unable to generate native block");
+            e.block = std::make_shared<channels::native_block>(std::move(*block));
+         } catch (...) {
+            e.error = std::current_exception();
+         }
+
+         std::lock_guard lock(mtx);
+         ready.emplace(seq, std::move(e));
+      }
+
+      const ship_block_decoder&                  decoder;
+      const std::size_t                          max_in_flight;
+      std::unique_ptr<boost::asio::thread_pool>  pool;
+      mutable std::mutex                         mtx;
+      uint64_t                                   next_seq = 0;
+      uint64_t                                   next_publish = 0;
+      std::map<uint64_t, entry>                  ready;
+};
@@ -1,9 +1,14 @@
 #include "ship_receiver_plugin.hpp"
+#include "ship_decoder.hpp"
+#include "native_block_log.hpp"
 #include "abi_utils.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+#include <fstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -27,21 +32,39 @@ class ship_receiver_plugin_impl : std::enable_shared_from_this<ship_receiver_plu
 
       using block_result_t = eosio::ship_protocol::get_blocks_result_v0;
       using native_block_t = channels::native_block;
-      static constexpr eosio::name pushtx = eosio::name("pushtx");
 
       void init(std::string h, std::string p, eosio::name ca,
-                std::optional<eosio::checksum256> start_block_id, int64_t start_block_timestamp) {
+                std::optional<eosio::checksum256> start_block_id, int64_t start_block_timestamp,
+                uint32_t decode_threads, uint32_t max_blocks_in_flight, uint32_t max_messages,
+                std::optional<std::string> record_path) {
          SILK_DEBUG << "ship_receiver_plugin_impl INIT";
          host = std::move(h);
          port = std::move(p);
          core_account = ca;
+         decoder = ship_block_decoder{ca};
+         pipeline = std::make_unique<ship_decode_pipeline>(decoder, decode_threads, max_blocks_in_flight);
+         max_messages_in_flight = std::max<uint32_t>(max_messages, 2);
+         SILK_INFO << "SHiP decode threads: " << decode_threads << ", max blocks in flight: " << max_blocks_in_flight
+                   << ", max messages in flight: " << max_messages_in_flight;
+         if (record_path) {
+            record_file.open(*record_path, std::ios::binary | std::ios::trunc);
+            if (!record_file.is_open()) {
+               throw std::runtime_error("Unable to open SHiP record file " + *record_path);
+            }
+            SILK_INFO << "Recording SHiP block messages to " << *record_path;
+         }
          start_from_block_id = start_block_id;
          start_from_block_timestamp = start_block_timestamp;
          resolver = std::make_shared<tcp::resolver>(appbase::app().get_io_service());
          stream   = std::make_shared<websocket::stream<tcp::socket>>(appbase::app().get_io_service());
          stream->binary(true);
          stream->read_message_max(0x1ull << 36);
-         connect_stream();
+      }
+
+      void enable_block_log(const std::string& dir, bool replay) {
+         block_log = std::make_unique<native_block_log>(dir);
+         replay_block_log = replay;
+         SILK_INFO << "Persisting native blocks to " << dir << (replay ? ", replay enabled" : "");
       }
 
       void initial_read() {
@@ -117,14 +140,14 @@ class ship_receiver_plugin_impl : std::enable_shared_from_this<ship_receiver_plu
          );
       }
 
-      void send_get_blocks_request(uint32_t start) {
+      void send_get_blocks_request(uint32_t start, std::vector<eosio::ship_protocol::block_position> have_positions = {}) {
          eosio::ship_protocol::request req = eosio::ship_protocol::get_blocks_request_v0{
             .start_block_num        = start,
             .end_block_num          = std::numeric_limits<uint32_t>::max(),
-            .max_messages_in_flight = 4*1024,
-            .have_positions         = {},
+            .max_messages_in_flight = max_messages_in_flight,
+            .have_positions         = std::move(have_positions),
             .irreversible_only      = false,
-            .fetch_block            = true,
+            .fetch_block            = true,  // needed for the block timestamp only, see start_native_block
             .fetch_traces           = true,
             .fetch_deltas           = false
          };
@@ -141,123 +164,70 @@ class ship_receiver_plugin_impl : std::enable_shared_from_this<ship_receiver_plu
          send_request(req);
       }
 
-      template <typename Buffer>
-      eosio::ship_protocol::result get_result(Buffer&& b){
-         auto data = b->data();
-         eosio::input_stream bin = {(const char*)data.data(), (const char*)data.data() + data.size()};
-         return eosio::from_bin<eosio::ship_protocol::result>(bin);
-      }
-
-      template <typename T>
-      std::optional<native_block_t> to_native(T&& block) {
-
-         if (!block.this_block) {
-           //TODO: throw here?
-           return std::nullopt;
-         }
-
-         auto current_block = start_native_block(block);
-
-         if (block.traces) {
-            uint32_t num;
-            eosio::varuint32_from_bin(num, *block.traces);
-            //SILK_DEBUG << "Block #" << block.this_block->block_num << " with " << num << " transactions";
-            for (std::size_t i = 0; i < num; i++) {
-               auto tt = eosio::from_bin<eosio::ship_protocol::transaction_trace>(*block.traces);
-               const auto& trace = std::get<eosio::ship_protocol::transaction_trace_v0>(tt);
-               const auto& actions = trace.action_traces;
-               bool found = false;
-               for (std::size_t j=0; j < actions.size(); j++) {
-                  std::visit([&](auto& act){
-                     if (act.act.name == pushtx && core_account == act.receiver) {
-                        append_to_block(current_block, trace, j);
-                        found = true;
-                     }
-                  }, actions[j]);
-                  if (found) break;
-               }
-            }
-         }
-
-         current_block.lib = block.last_irreversible.block_num;
-         return std::optional<native_block_t>(std::move(current_block));
-      }
-
-      template <typename BlockResult>
-      inline native_block_t start_native_block(BlockResult&& res) const {
-         native_block_t block;
-         eosio::ship_protocol::signed_block sb;
-         eosio::from_bin(sb, *res.block);
-
-         block.block_num = res.this_block->block_num;
-         block.id        = res.this_block->block_id;
-         block.prev      = res.prev_block->block_id;
-         block.timestamp = sb.timestamp.to_time_point().time_since_epoch().count();
-
-         //SILK_INFO << "Started native block " << block.block_num;
-         return block;
-      }
-
-      template <typename Trace>
-      inline void append_to_block(native_block_t& block, Trace& trace, std::size_t idx) {
-         channels::native_trx native_trx = {trace.id, trace.cpu_usage_us, trace.elapsed};
-         const auto& actions = trace.action_traces;
-         //SILK_DEBUG << "Appending transaction ";
-         for (std::size_t j=idx; j < actions.size(); j++) {
-            std::visit([&](auto& act){
-               if (act.act.name == pushtx && core_account == act.receiver) {
-                   channels::native_action action = {
-                       act.action_ordinal,
-                       act.receiver,
-                       act.act.account,
-                       act.act.name,
-                       std::vector<char>(act.act.data.pos, act.act.data.end)
-                   };
-                   native_trx.actions.emplace_back(std::move(action));
-               }
-            }, actions[j]);
-            //SILK_DEBUG << "Appending action " << native_trx.actions.back().name.to_string();
-         }
-         block.transactions.emplace_back(std::move(native_trx));
-      }
-
      
       auto get_status(){
          send_get_status_request();
-         return std::get<eosio::ship_protocol::get_status_result_v0>(get_result(read()));;
+         return std::get<eosio::ship_protocol::get_status_result_v0>(decoder.get_result(read()));;
       }
 
       void shutdown() {
+         if (pipeline) pipeline->stop();
+         if (block_log) block_log->flush();
       }
 
       void start_read() {
-         static size_t num_messages = 0;
          async_read([this](auto buff) {
-            auto block = to_native(std::get<eosio::ship_protocol::get_blocks_result_v0>(get_result(buff)));
-            if(!block) {
-               sys::error("Unable to generate native block");
-               return;
+            record(*buff);
+            pipeline->submit(buff, [this]() {
+               appbase::app().post(80, [this]() { publish_decoded(); });
+            });
+
+            // Give back the consumed half of the window so SHiP keeps streaming without a gap
+            if(++unacked_messages >= max_messages_in_flight / 2) {
+               send_get_blocks_ack_request(unacked_messages);
+               unacked_messages = 0;
             }
 
-            native_blocks_channel.publish(80, std::make_shared<channels::native_block>(std::move(*block)));
-
-            if(++num_messages % 1024 == 0) {
-               //SILK_INFO << "Block #" << block->block_num;
-               send_get_blocks_ack_request(num_messages);
+            // Stop reading while the decode window is full, publish_decoded resumes once it has room again
+            if (pipeline->full()) {
+               read_paused = true;
+               return;
             }
-
             start_read();
          });
       }
 
-      void sync() {
-         // get available blocks range we can grab
-         auto res = get_status();
+      void publish_decoded() {
+         try {
+            pipeline->drain([this](auto block) {
+               if (block_log) block_log->append(*block);
+               native_blocks_channel.publish(80, std::move(block));
+            });
+         } catch (const std::exception& ex) {
+            sys::error(ex.what());
+            return;
+         }
 
+         if (read_paused && !pipeline->full()) {
+            read_paused = false;
+            start_read();
+         }
+      }
+
+      // Append the raw message to the record file (length prefixed) so it can be replayed by ship_decode_bench
+      void record(const flat_buffer& buff) {
+         if (!record_file.is_open()) return;
+         auto data = buff.data();
+         uint32_t size = data.size();
+         record_file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+         record_file.write(static_cast<const char*>(data.data()), size);
+      }
+
+      std::optional<uint32_t> get_start_block_num() {
          auto head_header = appbase::app().get_plugin<engine_plugin>().get_head_canonical_header();
          if (!head_header) {
             sys::error("Unable to read canonical header");
-            return;
+            return {};
          }
          SILK_INFO << "get_head_canonical_header: "
                      << "#" << head_header->number
@@ -272,6 +242,67 @@ class ship_receiver_plugin_impl : std::enable_shared_from_this<ship_receiver_plu
             SILK_INFO << "Using specified start block number:" << block_num;
             start_from = block_num;
          }
+         return start_from;
+      }
+
+      void start() {
+         auto start_from = get_start_block_num();
+         if (!start_from) return;
+
+         if (replay_block_log && block_log && !block_log->empty() &&
+             *block_log->first_block_num() <= *start_from && *start_from <= *block_log->last_block_num()) {
+            SILK_INFO << "Replaying native block log from block #" << *start_from
+                      << " to #" << *block_log->last_block_num();
+            replay(std::make_shared<native_block_log::reader>(*block_log), *start_from);
+            return;
+         }
+
+         sync(*start_from);
+      }
+
+      // Publish the logged blocks in batches, yielding to the application queue in between so that the subscribers
+      // keep up, then continue from SHiP with the block following the end of the log. The reversible tail of the log
+      // may have been forked out while we were down: its ids are sent along so that SHiP restarts from the first
+      // block that differs, which then reaches block conversion as a regular fork.
+      void replay(std::shared_ptr<native_block_log::reader> reader, uint32_t next) {
+         const auto last = *block_log->last_block_num();
+         try {
+            for (uint32_t n = 0; n < replay_batch_size && next <= last; ++n, ++next) {
+               native_blocks_channel.publish(80, reader->read(next));
+            }
+         } catch (const std::exception& ex) {
+            sys::error(ex.what());
+            return;
+         }
+
+         if (next <= last) {
+            appbase::app().post(80, [this, reader, next]() { replay(reader, next); });
+            return;
+         }
+
+         std::vector<eosio::ship_protocol::block_position> have_positions;
+         try {
+            const auto lib = reader->read(last)->lib;
+            for (uint32_t n = std::max(lib + 1, *block_log->first_block_num()); n <= last; ++n) {
+               have_positions.push_back({n, reader->read(n)->id});
+            }
+         } catch (const std::exception& ex) {
+            sys::error(ex.what());
+            return;
+         }
+
+         SILK_INFO << "Replayed native block log up to block #" << last << ", " << have_positions.size() << " reversible";
+         appbase::app().post(80, [this, next, have_positions = std::move(have_positions)]() mutable {
+            sync(next, std::move(have_positions));
+         });
+      }
+
+      void sync(uint32_t start_from, std::vector<eosio::ship_protocol::block_position> have_positions = {}) {
+         connect_stream();
+         initial_read();
+
+         // get available blocks range we can grab
+         auto res = get_status();
 
          if( res.trace_begin_block > start_from ) {
             SILK_ERROR << "Block #" << start_from << " not available in SHiP";
@@ -280,7 +311,7 @@ class ship_receiver_plugin_impl : std::enable_shared_from_this<ship_receiver_plu
          }
 
          SILK_INFO << "Starting from block #" << start_from;
-         send_get_blocks_request(start_from);
+         send_get_blocks_request(start_from, std::move(have_positions));
          start_read();
       }
 
@@ -305,6 +336,15 @@ class ship_receiver_plugin_impl : std::enable_shared_from_this<ship_receiver_plu
       eosio::name                                     core_account;
       std::optional<eosio::checksum256>               start_from_block_id;
       int64_t                                         start_from_block_timestamp{};
+      ship_block_decoder                              decoder;
+      std::unique_ptr<ship_decode_pipeline>           pipeline;
+      bool                                            read_paused = false;
+      uint32_t                                        max_messages_in_flight = 4*1024;
+      uint32_t                                        unacked_messages = 0;
+      std::ofstream                                   record_file;
+      std::unique_ptr<native_block_log>               block_log;
+      bool                                            replay_block_log = false;
+      constexpr static uint32_t                       replay_batch_size = 512;
 };
 
 ship_receiver_plugin::ship_receiver_plugin() : my(new ship_receiver_plugin_impl) {}
@@ -320,6 +360,18 @@ void ship_receiver_plugin::set_program_options( appbase::options_description& cl
         "Override Antelope block id to start syncing from"  )
       ("ship-start-from-block-timestamp", boost::program_options::value<int64_t>(),
         "Timestamp for the provided ship-start-from-block-id, required if block-id provided"  )
+      ("ship-decode-threads", boost::program_options::value<uint32_t>()->default_value(4),
+        "Number of threads decoding SHiP blocks, 0 decodes on the main thread")
+      ("ship-max-blocks-in-flight", boost::program_options::value<uint32_t>()->default_value(256),
+        "Maximum number of SHiP blocks read but not yet published")
+      ("ship-max-messages-in-flight", boost::program_options::value<uint32_t>()->default_value(4*1024),
+        "SHiP streaming window: messages sent before waiting for an acknowledgement, acknowledged every half window")
+      ("ship-record-file", boost::program_options::value<std::string>(),
+        "Optionally record raw SHiP block messages into the specified file for replay by ship_decode_bench")
+      ("ship-block-log-dir", boost::program_options::value<std::string>(),
+        "Optionally persist the received native blocks (EVM actions only) into a block log in the specified directory")
+      ("ship-replay-block-log", boost::program_options::value<bool>()->default_value(false),
+        "Replay the native blocks available in ship-block-log-dir before connecting to SHiP")
    ;
 }
 
@@ -340,17 +392,31 @@ void ship_receiver_plugin::plugin_initialize( const appbase::variables_map& opti
       throw std::runtime_error("ship-start-from-block-timestamp only valid if ship-start-from-block-id provided");
    }
 
-   my->init(endpoint.substr(0, i), endpoint.substr(i+1), eosio::name(core), start_block_id, start_block_timestamp);
+   std::optional<std::string> record_path;
+   if (options.contains("ship-record-file")) {
+      record_path = options.at("ship-record-file").as<std::string>();
+   }
+
+   my->init(endpoint.substr(0, i), endpoint.substr(i+1), eosio::name(core), start_block_id, start_block_timestamp,
+            options.at("ship-decode-threads").as<uint32_t>(), options.at("ship-max-blocks-in-flight").as<uint32_t>(),
+            options.at("ship-max-messages-in-flight").as<uint32_t>(), record_path);
+
+   const bool replay = options.at("ship-replay-block-log").as<bool>();
+   if (options.contains("ship-block-log-dir")) {
+      my->enable_block_log(options.at("ship-block-log-dir").as<std::string>(), replay);
+   } else if (replay) {
+      throw std::runtime_error("ship-replay-block-log requires ship-block-log-dir");
+   }
    SILK_INFO << "Initialized SHiP Receiver Plugin";
 }
 
 void ship_receiver_plugin::plugin_startup() {
    SILK_INFO << "Started SHiP Receiver";
-   my->initial_read();
-   my->sync();
+   my->start();
 }
 
 void ship_receiver_plugin::plugin_shutdown() {
+   my->shutdown();
    SILK_INFO << "Shutdown SHiP Receiver";
 }
 
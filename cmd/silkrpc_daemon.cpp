@@ -16,6 +16,7 @@
 
 #include <silkrpc/config.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -36,11 +37,15 @@ ABSL_FLAG(std::string, http_port, silkrpc::kDefaultHttpPort, "Ethereum JSON RPC
 ABSL_FLAG(std::string, engine_port, silkrpc::kDefaultEnginePort, "Engine JSON RPC API local end-point as string <address>:<port>");
 ABSL_FLAG(std::string, target, silkrpc::kDefaultTarget, "Erigon Core gRPC service location as string <address>:<port>");
 ABSL_FLAG(std::string, api_spec, silkrpc::kDefaultEth1ApiSpec, "JSON RPC API namespaces as comma-separated list of strings");
-ABSL_FLAG(uint32_t, num_contexts, std::thread::hardware_concurrency() / 3, "number of running I/O contexts as 32-bit integer");
+ABSL_FLAG(uint32_t, num_contexts, std::max(std::thread::hardware_concurrency() / 3, 1u), "number of running I/O contexts as 32-bit integer");
 ABSL_FLAG(uint32_t, num_workers, 16, "number of worker threads as 32-bit integer");
 ABSL_FLAG(uint32_t, timeout, silkrpc::kDefaultTimeout.count(), "gRPC call timeout as 32-bit integer");
 ABSL_FLAG(silkrpc::LogLevel, log_verbosity, silkrpc::LogLevel::Critical, "logging verbosity level");
 ABSL_FLAG(silkrpc::WaitMode, wait_mode, silkrpc::WaitMode::blocking, "scheduler wait mode");
+ABSL_FLAG(bool, http_round_robin, false, "accept HTTP connections on one context and run them on every context in turn");
+ABSL_FLAG(uint32_t, max_readers, silkrpc::kDefaultMaxReaders, "maximum number of chaindata readers as 32-bit integer");
+ABSL_FLAG(uint32_t, max_cursor_read_ahead, silkrpc::kDefaultMaxCursorReadAhead, "max records read ahead in one round trip by KV cursors as 32-bit integer (1 disables it)");
+ABSL_FLAG(uint32_t, max_batch_size, silkrpc::kDefaultMaxBatchSize, "maximum number of requests in a JSON RPC batch as 32-bit integer");
 
 //! Assemble the application version using the Cable build information
 std::string get_version_from_build_info() {
@@ -100,7 +105,11 @@ silkrpc::DaemonSettings parse_args(int argc, char* argv[]) {
         absl::GetFlag(FLAGS_num_contexts),
         absl::GetFlag(FLAGS_num_workers),
         absl::GetFlag(FLAGS_log_verbosity),
-        absl::GetFlag(FLAGS_wait_mode)
+        absl::GetFlag(FLAGS_wait_mode),
+        absl::GetFlag(FLAGS_max_batch_size),
+        absl::GetFlag(FLAGS_http_round_robin),
+        absl::GetFlag(FLAGS_max_readers),
+        absl::GetFlag(FLAGS_max_cursor_read_ahead)
     };
 
     return rpc_daemon_settings;
@@ -70,6 +70,55 @@ public:
 
    [[eosio::action]] void pushtx(eosio::name miner, const bytes& rlptx);
 
+   /**
+    * @brief Execute several EVM transactions in a single action.
+    *
+    * Each transaction is validated, executed and paid for exactly as if it had been sent in its own pushtx action, in
+    * the given order, but the block setup and the state write happen once for the whole batch. Reserved (bridge)
+    * addresses are emptied after each transaction, so a transaction never sees what the previous ones bridged out.
+    *
+    * The batch is atomic: a transaction rejected by validation fails the whole action and none of the transactions
+    * is applied. Callers needing per transaction outcomes can check the batch with dryrun first. A transaction that
+    * executes without success (e.g. reverts) is not rejected; it is included and charged as with pushtx.
+    *
+    * @param miner Account receiving the miner cut of every transaction of the batch.
+    * @param rlptxs RLP encoded transactions.
+    */
+   [[eosio::action]] void pushtxs(eosio::name miner, const std::vector<bytes>& rlptxs);
+
+   enum class dryrun_status : uint8_t
+   {
+      ok = 0,             ///< pushtx would accept the transaction
+      undecodable = 1,    ///< not a valid RLP encoded transaction
+      fee_rejected = 2,   ///< max_priority_fee_per_gas differs from max_fee_per_gas or the gas price is too low
+      bad_sender = 3,     ///< the sender cannot be recovered or is a reserved (bridge) address
+      invalid = 4,        ///< pre_validate_transaction or validate_transaction failed, see detail
+      failed = 5          ///< executed without success, the transaction would still be included and charged
+   };
+
+   struct dryrun_result
+   {
+      uint8_t status = 0;   ///< dryrun_status
+      uint8_t detail = 0;   ///< silkworm ValidationResult of an invalid transaction
+      uint64_t gas_used = 0; ///< gas used by an executed transaction
+   };
+
+   /**
+    * @brief Check EVM transactions the way pushtx would, without changing any state.
+    *
+    * Meant for relayers to reject bad transactions before paying for them, through a read-only transaction. The
+    * transactions are checked in order against a shared in-memory state, so that consecutive transactions of a sender
+    * see the nonces of the previous ones. Without `execute`, a valid transaction only takes its nonce and its upfront
+    * cost (gas limit times gas price, plus value) from the sender. With `execute`, it is run and its effects are seen
+    * by the following transactions. Nothing is written to the database either way, and the checks of bridge
+    * transfers to native accounts are not part of the dry run.
+    *
+    * @param rlptxs RLP encoded transactions.
+    * @param execute Whether to execute the valid transactions.
+    * @return one result per transaction, in order
+    */
+   [[eosio::action]] std::vector<dryrun_result> dryrun(const std::vector<bytes>& rlptxs, bool execute);
+
    [[eosio::action]] void open(eosio::name owner);
 
    [[eosio::action]] void close(eosio::name owner);
@@ -82,6 +131,39 @@ public:
    /// @return true if all garbage has been collected
    [[eosio::action]] bool gc(uint32_t max);
 
+   /**
+    * @brief Set the garbage collection done by pushed transactions.
+    *
+    * Every transaction of pushtx and pushtxs then erases up to `rows_per_tx` storage rows of removed accounts, resuming
+    * where the previous collection stopped. Throughput is kept in the gcstate table, the backlog is the gcstore table.
+    *
+    * @param rows_per_tx Rows erased per transaction, 0 leaves collection to the gc action.
+    */
+   [[eosio::action]] void setgcparams(uint32_t rows_per_tx);
+
+   /**
+    * @brief Move up to `max` rows of the legacy storage table to the v2 storage layout.
+    *
+    * Progress is kept between calls, so the action can be repeated until it returns true while the contract keeps
+    * serving transactions. Slots whose v2 primary key is already taken by another slot stay in the legacy table.
+    * Requires the authority of the contract, which pays for the RAM of the moved rows.
+    *
+    * @return true if every legacy row has been visited
+    */
+   [[eosio::action]] bool migratestor(uint32_t max);
+
+   /**
+    * @brief Moves up to `max` rows of the legacy `account` table to the compact `account2` layout.
+    *
+    * Rows keep their id, which is the scope of the account storage. Migrated rows are erased from the legacy table,
+    * so the action can be repeated until it returns true while the contract keeps serving transactions; accounts
+    * written in the meantime are converted as part of the write. Requires the authority of the contract, which pays
+    * for the RAM of the converted rows.
+    *
+    * @return true if the legacy account table is empty
+    */
+   [[eosio::action]] bool migrateacct(uint32_t max);
+
 #ifdef WITH_TEST_ACTIONS
    [[eosio::action]] void testtx(const std::optional<bytes>& orlptx, const evm_runtime::test::block_info& bi);
    [[eosio::action]] void
@@ -131,6 +213,8 @@ private:
 
    silkworm::Receipt execute_tx(eosio::name miner, silkworm::Block& block, silkworm::Transaction& tx, silkworm::ExecutionProcessor& ep);
 
+   void execute_rlptxs(eosio::name miner, const bytes* first, const bytes* last);
+
    uint64_t get_and_increment_nonce(const name owner);
 
    checksum256 get_code_hash(name account) const;
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <ethash/hash_types.hpp>
+#include <silkworm/types/transaction.hpp>
+
+namespace evm_runtime {
+
+/// Sets the sender of `tx`. Built with WITH_HOST_CRYPTO, the signature is recovered by the k1_recover and sha3 host
+/// functions, falling back to silkworm's Wasm implementation only when the host rejects it.
+void recover_sender(silkworm::Transaction& tx);
+
+#ifdef WITH_HOST_CRYPTO
+/// Keccak-256 computed by the sha3 host function
+ethash::hash256 keccak256(const void* data, size_t size);
+#endif
+
+} // namespace evm_runtime
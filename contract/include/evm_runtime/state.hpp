@@ -2,8 +2,10 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include <eosio/eosio.hpp>
 #include <evm_runtime/types.hpp>
+#include <evm_runtime/tables.hpp>
 #include <silkworm/state/state.hpp>
 
 namespace evm_runtime {
@@ -23,13 +25,49 @@ struct db_stats {
     table_stats storage;
 };
 
+// Append-only buffer holding the code rows read during an action. Chunks are neither moved nor freed before the arena
+// is destroyed, so the views handed out to the EVM stay valid for the whole action.
+class code_arena {
+public:
+    char* allocate(size_t size);
+
+private:
+    // Fits the largest deployable code (EIP-170) with its row
+    static constexpr size_t chunk_size = 32 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    size_t _used = 0;
+    size_t _capacity = 0;
+};
+
+// Account row of either table in the compact layout. Rows still in the legacy table are converted when first written.
+struct cached_account {
+    account_v2 row;
+    bool legacy = false;
+};
+
 struct state : State {
     name _self;
     name _ram_payer;
-    mutable std::map<evmc::address, uint64_t> addr2id;
-    mutable std::map<bytes32, bytes> addr2code;
+    mutable std::map<evmc::address, std::optional<cached_account>> addr2account;
+    // Code read during the action, pointing into _code_arena
+    mutable std::map<bytes32, ByteView> addr2code;
     mutable db_stats stats;
 
+    // Table objects are kept for the lifetime of the state so that the rows loaded by reads are reused by the writes
+    // that follow, and each address goes through the by.address index only once.
+    mutable std::optional<account_v2_table> _accounts;
+    mutable std::optional<account_table> _legacy_accounts;
+    // Whether the legacy account table still holds rows, only then is it searched
+    mutable std::optional<bool> _has_legacy_accounts;
+    mutable std::map<uint64_t, storage_table> _storages;
+    mutable std::map<uint64_t, storage_v2_table> _slots;
+    // Whether the legacy storage table of an account still holds rows, only then is it searched
+    mutable std::map<uint64_t, bool> _legacy_storage;
+    // Code rows whose hash was seen by read_account, so read_code finds them by primary key
+    mutable std::map<bytes32, uint64_t> _code_ids;
+    mutable code_arena _code_arena;
+
     explicit state(name self, name ram_payer) : _self(self), _ram_payer(ram_payer){}
 
     std::optional<Account> read_account(const evmc::address& address) const noexcept override;
@@ -72,6 +110,17 @@ struct state : State {
     /// @return true if all garbage has been collected
     bool gc(uint32_t max);
 
+    /// Collects the garbage budgeted in gcstate for `txs` pushed transactions, if any
+    void gc_pushed(uint32_t txs);
+
+    /// Moves up to `max` rows of the legacy storage table to the v2 layout
+    /// @return true if every legacy row has been visited
+    bool migrate_storage(uint32_t max);
+
+    /// Moves up to `max` rows of the legacy account table to the compact layout
+    /// @return true if the legacy account table is empty
+    bool migrate_accounts(uint32_t max);
+
     void update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash,
                              ByteView code) override;
 
@@ -79,6 +128,26 @@ struct state : State {
                         const evmc::bytes32& initial, const evmc::bytes32& current) override;
 
     void unwind_state_changes(uint64_t block_number) override;
+
+private:
+    account_v2_table& accounts() const;
+    account_table& legacy_accounts() const;
+    bool has_legacy_accounts() const;
+    /// @return the lowest account id not below `id` in either account table
+    std::optional<uint64_t> next_account(uint64_t id) const;
+    storage_table& storage_of(uint64_t account_id) const;
+    storage_v2_table& slots_of(uint64_t account_id) const;
+    std::optional<evmc::bytes32> code_hash_of(uint64_t code_id) const;
+    ByteView load_code(uint64_t code_id) const;
+    bool has_legacy_storage(uint64_t account_id) const;
+
+    /// @return the account of `address` or nullptr if it does not exist
+    cached_account* find_account(const evmc::address& address) const;
+    const account_v2& create_account(const evmc::address& address, uint64_t nonce, const uint256be& balance,
+                                     std::optional<uint64_t> code_id = std::nullopt);
+    /// Writes the cached row back, moving it to the compact table if it comes from the legacy one
+    void write_account(cached_account& cached);
+    void remove_account(const evmc::address& address, cached_account& cached);
 };
 
 }  // namespace evm_runtime
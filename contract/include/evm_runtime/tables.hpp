@@ -35,6 +35,71 @@ typedef multi_index< "account"_n, account,
     indexed_by<"by.address"_n, const_mem_fun<account, checksum256, &account::by_eth_address>>
 > account_table;
 
+// Compact account layout: fixed width address and balance and no optional, so a row is serialized without any
+// allocation. Accounts are written in this layout whenever they are created or updated, and migrateacct moves the
+// remaining legacy rows over. A row keeps the id of its legacy row since the id is the scope of the account storage.
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] account_v2 {
+    uint64_t    id;
+    checksum160 eth_address;
+    uint64_t    nonce;
+    checksum256 balance;  // big-endian
+    uint64_t    code_id;  // account_code id plus one, 0 when the account has no code
+
+    uint64_t primary_key()const { return id; }
+
+    checksum256 by_eth_address()const {
+        auto address = eth_address.extract_as_byte_array();
+        return make_key(address.data(), address.size());
+    }
+
+    evmc::address get_address()const {
+        evmc::address res;
+        auto address = eth_address.extract_as_byte_array();
+        std::copy(address.begin(), address.end(), res.bytes);
+        return res;
+    }
+
+    void set_address(const evmc::address& address) {
+        eth_address = checksum160{address.bytes};
+    }
+
+    uint256be get_balance()const {
+        uint256be res;
+        auto be = balance.extract_as_byte_array();
+        std::copy(be.begin(), be.end(), res.bytes);
+        return res;
+    }
+
+    void set_balance(const uint256be& value) {
+        balance = checksum256{value.bytes};
+    }
+
+    std::optional<uint64_t> get_code_id()const {
+        if (!code_id) return {};
+        return code_id - 1;
+    }
+
+    void set_code_id(std::optional<uint64_t> id) {
+        code_id = id ? *id + 1 : 0;
+    }
+
+    static account_v2 from_legacy(const account& legacy) {
+        account_v2 row;
+        row.id = legacy.id;
+        row.set_address(to_address(legacy.eth_address));
+        row.nonce = legacy.nonce;
+        row.set_balance(legacy.get_balance());
+        row.set_code_id(legacy.code_id);
+        return row;
+    }
+
+    EOSLIB_SERIALIZE(account_v2, (id)(eth_address)(nonce)(balance)(code_id));
+};
+
+typedef multi_index< "account2"_n, account_v2,
+    indexed_by<"by.address"_n, const_mem_fun<account_v2, checksum256, &account_v2::by_eth_address>>
+> account_v2_table;
+
 struct [[eosio::table]] [[eosio::contract("evm_contract")]] account_code {
     uint64_t    id;
     uint32_t    ref_count;
@@ -76,6 +141,59 @@ typedef multi_index< "storage"_n, storage,
     indexed_by<"by.key"_n, const_mem_fun<storage, checksum256, &storage::by_key>> 
 > storage_table;
 
+// Storage layout v2: the primary key is taken from the low 64 bits of the slot so a slot is found with a single
+// primary key lookup, without the by.key secondary index. `key` keeps the whole slot to tell apart slots sharing
+// their low 64 bits; such a slot lives in the legacy `storage` table instead.
+//
+// Values are 32-byte words stored big-endian with their leading zero bytes trimmed, as a length prefixed `bytes`
+// rather than a fixed checksum256: most slots hold small counters, balances or addresses, and trimming saves up to 31
+// bytes of RAM per row at the cost of the vector allocation and copy when the row is read or written. The full word
+// is rebuilt by get_value.
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] storage_v2 {
+    uint64_t    id;
+    checksum256 key;
+    bytes       value;
+
+    uint64_t primary_key()const { return id; }
+
+    static uint64_t id_of(const bytes32& slot) {
+        uint64_t id = 0;
+        for (size_t i = sizeof(slot.bytes) - sizeof(id); i < sizeof(slot.bytes); ++i) {
+            id = (id << 8) | slot.bytes[i];
+        }
+        return id;
+    }
+
+    bool holds(const bytes32& slot)const {
+        return key == make_key(slot);
+    }
+
+    bytes32 get_value()const {
+        bytes32 res;
+        std::copy(value.begin(), value.end(), res.bytes + sizeof(res.bytes) - value.size());
+        return res;
+    }
+
+    void set_value(const bytes32& v) {
+        auto first = std::find_if(std::begin(v.bytes), std::end(v.bytes), [](uint8_t b){ return b != 0; });
+        value.assign(first, std::end(v.bytes));
+    }
+
+    EOSLIB_SERIALIZE(storage_v2, (id)(key)(value));
+};
+
+typedef multi_index< "storagev2"_n, storage_v2> storage_v2_table;
+
+// Progress of the migration of the legacy `storage` rows to `storagev2`
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] storage_migration {
+    uint64_t next_account = 0;
+    uint64_t next_row = 0;
+
+    EOSLIB_SERIALIZE(storage_migration, (next_account)(next_row));
+};
+
+typedef eosio::singleton<"storagemig"_n, storage_migration> storage_migration_singleton;
+
 struct [[eosio::table]] [[eosio::contract("evm_contract")]] gcstore {
     uint64_t id;
     uint64_t storage_id;
@@ -87,6 +205,19 @@ struct [[eosio::table]] [[eosio::contract("evm_contract")]] gcstore {
 
 typedef multi_index< "gcstore"_n, gcstore> gc_store_table;
 
+// Settings and counters of the garbage collection of removed accounts' storage. Collected gcstore rows are erased, so
+// the tables still pending are the rows of gcstore and collection always resumes at its beginning. Only gc writes the
+// counters, removing an account does not touch this singleton.
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] gc_state {
+    uint32_t rows_per_tx = 0;  // budget of every pushed transaction, 0 leaves collection to the gc action
+    uint64_t collected   = 0;  // storage tables entirely collected
+    uint64_t rows_erased = 0;  // storage rows erased
+
+    EOSLIB_SERIALIZE(gc_state, (rows_per_tx)(collected)(rows_erased));
+};
+
+typedef eosio::singleton<"gcstate"_n, gc_state> gc_state_singleton;
+
 struct [[eosio::table("inevm")]] [[eosio::contract("evm_contract")]] balance_with_dust {
     asset balance = asset(0, token_symbol);
     uint64_t dust = 0;
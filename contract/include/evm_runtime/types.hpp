@@ -26,6 +26,7 @@ namespace evm_runtime {
    typedef evmc::bytes32           bytes32;
    typedef evmc::bytes32           uint256be;
 
+   eosio::checksum256 make_key(const uint8_t* ptr, size_t len);
    eosio::checksum256 make_key(bytes data);
    eosio::checksum256 make_key(const evmc::address& addr);
    eosio::checksum256 make_key(const evmc::bytes32& data);
@@ -6,6 +6,7 @@
 #include <evm_runtime/tables.hpp>
 #include <evm_runtime/state.hpp>
 #include <evm_runtime/intrinsics.hpp>
+#include <evm_runtime/host_crypto.hpp>
 #include <evm_runtime/eosio.token.hpp>
 
 #include <evm_common/block_mapping.hpp>
@@ -185,7 +186,7 @@ Receipt evm_contract::execute_tx( eosio::name miner, Block& block, Transaction&
     };
 
     tx.from.reset();
-    tx.recover_sender();
+    recover_sender(tx);
     eosio::check(tx.from.has_value(), "unable to recover sender");
     LOGTIME("EVM RECOVER SENDER");
 
@@ -216,12 +217,15 @@ Receipt evm_contract::execute_tx( eosio::name miner, Block& block, Transaction&
     check_result( r, tx, "validate_transaction error" );
 
     Receipt receipt;
+    const uint64_t gas_used_before = ep.cumulative_gas_used();
     ep.execute_transaction(tx, receipt);
+    // Report the gas of this transaction alone, as if it had been the only one of the action
+    receipt.cumulative_gas_used -= gas_used_before;
 
     // Calculate the miner portion of the actual gas fee (if necessary):
     std::optional<intx::uint256> gas_fee_miner_portion;
     if (miner) {
-        uint64_t tx_gas_used = receipt.cumulative_gas_used; // Only transaction in the "block" so cumulative_gas_used is the tx gas_used.
+        uint64_t tx_gas_used = receipt.cumulative_gas_used;
         intx::uint512 gas_fee = intx::uint256(tx_gas_used) * tx.max_fee_per_gas;
         check(gas_fee < std::numeric_limits<intx::uint256>::max(), "too much gas");
         gas_fee *= _config.get().miner_cut;
@@ -237,6 +241,7 @@ Receipt evm_contract::execute_tx( eosio::name miner, Block& block, Transaction&
         intx::uint256 total_egress;
         populate_bridge_accessors();
 
+        std::vector<evmc::address> bridged_out;
         for(const auto& reserved_object : ep.state().reserved_objects()) {
             const evmc::address& address = reserved_object.first;
             const name egress_account(*extract_reserved_address(address));
@@ -245,13 +250,15 @@ Receipt evm_contract::execute_tx( eosio::name miner, Block& block, Transaction&
             check(reserved_account.code_hash == kEmptyHash, "contracts cannot be created in the reserved address space");
             check(egress_account.value != 0, "reserved 0 address cannot be used");
 
-            if(reserved_account.balance ==  0_u256)
+            const intx::uint256 egress_amount = reserved_account.balance;
+            if(egress_amount ==  0_u256)
                 continue;
-            total_egress += reserved_account.balance;
+            bridged_out.push_back(address);
+            total_egress += egress_amount;
 
             if(auto it = balance_table.find(egress_account.value); it != balance_table.end()) {
                 balance_table.modify(balance_table.get(egress_account.value), eosio::same_payer, [&](balance& b){
-                    b.balance += reserved_account.balance;
+                    b.balance += egress_amount;
                     if (gas_fee_miner_portion.has_value() && egress_account == get_self()) {
                         check(!deducted_miner_cut, "unexpected error: contract account appears twice in reserved objects");
                         b.balance -= *gas_fee_miner_portion;
@@ -265,13 +272,13 @@ Receipt evm_contract::execute_tx( eosio::name miner, Block& block, Transaction&
                 if(get_code_hash(egress_account) != checksum256())
                     egresslist(get_self(), get_self().value).get(egress_account.value, "non-open accounts containing contract code must be on allow list for egress bridging");
 
-                check(reserved_account.balance % minimum_natively_representable == 0_u256, "egress bridging to non-open accounts must not contain dust");
+                check(egress_amount % minimum_natively_representable == 0_u256, "egress bridging to non-open accounts must not contain dust");
 
                 const bool was_to = tx.to && *tx.to == address;
                 const Bytes exit_memo = {'E', 'V', 'M', ' ', 'e', 'x', 'i', 't'}; //yikes
 
                 token::transfer_bytes_memo_action transfer_act(token_account, {{get_self(), "active"_n}});
-                transfer_act.send(get_self(), egress_account, asset((uint64_t)(reserved_account.balance / minimum_natively_representable), token_symbol), was_to ? tx.data : exit_memo);
+                transfer_act.send(get_self(), egress_account, asset((uint64_t)(egress_amount / minimum_natively_representable), token_symbol), was_to ? tx.data : exit_memo);
 
                 non_open_account_sent = true;
             }
@@ -279,6 +286,11 @@ Receipt evm_contract::execute_tx( eosio::name miner, Block& block, Transaction&
 
         if(total_egress != 0_u256)
             inevm->set(inevm->get() -= total_egress, eosio::same_payer);
+
+        // The state is shared by the transactions of a pushtxs batch: empty the reserved addresses again, so that the
+        // next transaction starts with them at zero as it would in its own pushtx
+        for(const auto& address : bridged_out)
+            ep.state().set_balance(address, 0);
     }
 
     // Send miner portion of the gas fee, if any, to the balance of the miner:
@@ -301,6 +313,99 @@ void evm_contract::pushtx( eosio::name miner, const bytes& rlptx ) {
     eosio::check((get_sender() != get_self()) || (miner == get_self()),
                  "unexpected error: EVM contract generated inline pushtx without setting itself as the miner");
 
+    execute_rlptxs(miner, &rlptx, &rlptx + 1);
+}
+
+void evm_contract::pushtxs( eosio::name miner, const std::vector<bytes>& rlptxs ) {
+    LOGTIME("EVM START");
+
+    assert_unfrozen();
+
+    // The bridge relies on inline pushtx, which funds the reserved sender of a single transaction
+    eosio::check(get_sender() != get_self(), "unexpected error: EVM contract generated inline pushtxs");
+    eosio::check(!rlptxs.empty(), "no transactions to push");
+
+    execute_rlptxs(miner, rlptxs.data(), rlptxs.data() + rlptxs.size());
+}
+
+std::vector<evm_contract::dryrun_result> evm_contract::dryrun( const std::vector<bytes>& rlptxs, bool execute ) {
+    assert_unfrozen();
+
+    const auto& current_config = _config.get();
+    std::optional<std::pair<const std::string, const ChainConfig*>> found_chain_config = lookup_known_chain(current_config.chainid);
+    check( found_chain_config.has_value(), "failed to find expected chain config" );
+
+    evm_common::block_mapping bm(current_config.genesis_time.sec_since_epoch());
+
+    Block block;
+    evm_common::prepare_block_header(block.header, bm, get_self().value,
+        bm.timestamp_to_evm_block_num(eosio::current_time_point().time_since_epoch().count()));
+
+    silkworm::consensus::TrustEngine engine{*found_chain_config->second};
+
+    // The state is only read from, write_to_db is never called
+    evm_runtime::state state{get_self(), get_self()};
+    silkworm::ExecutionProcessor ep{block, engine, state, *found_chain_config->second};
+
+    std::vector<dryrun_result> results;
+    results.reserve(rlptxs.size());
+    for (const auto& rlptx : rlptxs) {
+        auto& result = results.emplace_back();
+        auto reject = [&](dryrun_status status, uint8_t detail = 0) {
+            result.status = static_cast<uint8_t>(status);
+            result.detail = detail;
+        };
+
+        Transaction tx;
+        ByteView bv{(const uint8_t*)rlptx.data(), rlptx.size()};
+        if (rlp::decode(bv, tx) != DecodingResult::kOk || !bv.empty()) {
+            reject(dryrun_status::undecodable);
+            continue;
+        }
+
+        if (tx.max_priority_fee_per_gas != tx.max_fee_per_gas || tx.max_fee_per_gas < current_config.gas_price) {
+            reject(dryrun_status::fee_rejected);
+            continue;
+        }
+
+        tx.from.reset();
+        recover_sender(tx);
+        // Reserved senders are only valid in the inline pushtx of the bridge
+        if (!tx.from || is_reserved_address(*tx.from)) {
+            reject(dryrun_status::bad_sender);
+            continue;
+        }
+
+        ValidationResult r = consensus::pre_validate_transaction(tx, ep.evm().block().header.number, ep.evm().config(),
+                                                                 ep.evm().block().header.base_fee_per_gas);
+        if (r == ValidationResult::kOk) {
+            r = ep.validate_transaction(tx);
+        }
+        if (r != ValidationResult::kOk) {
+            reject(dryrun_status::invalid, static_cast<uint8_t>(r));
+            continue;
+        }
+
+        if (execute) {
+            Receipt receipt;
+            const uint64_t gas_used_before = ep.cumulative_gas_used();
+            ep.execute_transaction(tx, receipt);
+            result.gas_used = receipt.cumulative_gas_used - gas_used_before;
+            if (!receipt.success) {
+                reject(dryrun_status::failed);
+            }
+        } else {
+            // validate_transaction guarantees the sender can cover this
+            const intx::uint512 upfront_cost = intx::uint256(tx.gas_limit) * tx.max_fee_per_gas + tx.value;
+            ep.state().subtract_from_balance(*tx.from, static_cast<intx::uint256>(upfront_cost));
+            ep.state().set_nonce(*tx.from, tx.nonce + 1);
+        }
+    }
+
+    return results;
+}
+
+void evm_contract::execute_rlptxs( eosio::name miner, const bytes* first, const bytes* last ) {
     const auto& current_config = _config.get();
     std::optional<std::pair<const std::string, const ChainConfig*>> found_chain_config = lookup_known_chain(current_config.chainid);
     check( found_chain_config.has_value(), "failed to find expected chain config" );
@@ -316,18 +421,30 @@ void evm_contract::pushtx( eosio::name miner, const bytes& rlptx ) {
     evm_runtime::state state{get_self(), get_self()};
     silkworm::ExecutionProcessor ep{block, engine, state, *found_chain_config->second};
 
-    Transaction tx;
-    ByteView bv{(const uint8_t*)rlptx.data(), rlptx.size()};
-    eosio::check(rlp::decode(bv,tx) == DecodingResult::kOk && bv.empty(), "unable to decode transaction");
-    LOGTIME("EVM TX DECODE");
+    for (auto rlptx = first; rlptx != last; ++rlptx) {
+        Transaction tx;
+        ByteView bv{(const uint8_t*)rlptx->data(), rlptx->size()};
+        eosio::check(rlp::decode(bv,tx) == DecodingResult::kOk && bv.empty(), "unable to decode transaction");
+        LOGTIME("EVM TX DECODE");
 
-    check(tx.max_priority_fee_per_gas == tx.max_fee_per_gas, "max_priority_fee_per_gas must be equal to max_fee_per_gas");
-    check(tx.max_fee_per_gas >= current_config.gas_price, "gas price is too low");
+        check(tx.max_priority_fee_per_gas == tx.max_fee_per_gas, "max_priority_fee_per_gas must be equal to max_fee_per_gas");
+        check(tx.max_fee_per_gas >= current_config.gas_price, "gas price is too low");
 
-    auto receipt = execute_tx(miner, block, tx, ep);
+        execute_tx(miner, block, tx, ep);
+    }
 
     engine.finalize(ep.state(), ep.evm().block(), ep.evm().revision());
     ep.state().write_to_db(ep.evm().block().header.number);
+
+    state.gc_pushed(static_cast<uint32_t>(last - first));
+
+#ifdef WITH_DB_STATS
+    // Parsed by the profiling harness in tests/profile_tests.cpp
+    const auto& stats = state.stats;
+    eosio::print("db_stats account ", stats.account.read, " ", stats.account.update, " ", stats.account.create, " ",
+                 stats.account.remove, " storage ", stats.storage.read, " ", stats.storage.update, " ",
+                 stats.storage.create, " ", stats.storage.remove, "\n");
+#endif
 }
 
 void evm_contract::open(eosio::name owner) {
@@ -473,6 +590,32 @@ bool evm_contract::gc(uint32_t max) {
     return state.gc(max);
 }
 
+void evm_contract::setgcparams(uint32_t rows_per_tx) {
+    assert_inited();
+    require_auth(get_self());
+
+    gc_state_singleton progress(get_self(), get_self().value);
+    auto gcs = progress.get_or_default();
+    gcs.rows_per_tx = rows_per_tx;
+    progress.set(gcs, get_self());
+}
+
+bool evm_contract::migratestor(uint32_t max) {
+    assert_unfrozen();
+    require_auth(get_self());
+
+    evm_runtime::state state{get_self(), get_self()};
+    return state.migrate_storage(max);
+}
+
+bool evm_contract::migrateacct(uint32_t max) {
+    assert_unfrozen();
+    require_auth(get_self());
+
+    evm_runtime::state state{get_self(), get_self()};
+    return state.migrate_accounts(max);
+}
+
 #ifdef WITH_TEST_ACTIONS
 [[eosio::action]] void evm_contract::testtx( const std::optional<bytes>& orlptx, const evm_runtime::test::block_info& bi ) {
     assert_unfrozen();
@@ -502,10 +645,17 @@ bool evm_contract::gc(uint32_t max) {
 
     eosio::require_auth(get_self());
 
-    account_table accounts(_self, _self.value);
+    std::optional<uint64_t> account_id;
+    account_v2_table accounts(_self, _self.value);
     auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(to_address(addy)));
-    if(itr == inx.end()) {
+    if(auto itr = inx.find(make_key(to_address(addy))); itr != inx.end()) {
+        account_id = itr->id;
+    } else {
+        account_table legacy(_self, _self.value);
+        auto linx = legacy.get_index<"by.address"_n>();
+        if(auto litr = linx.find(make_key(to_address(addy))); litr != linx.end()) account_id = litr->id;
+    }
+    if(!account_id) {
         eosio::print("no data for: ");
         eosio::printhex(addy.data(), addy.size());
         eosio::print("\n");
@@ -516,7 +666,7 @@ bool evm_contract::gc(uint32_t max) {
     eosio::printhex(addy.data(), addy.size());
 
     uint64_t cnt=0;
-    storage_table db(_self, itr->id);
+    storage_table db(_self, *account_id);
     auto sitr = db.begin();
     while(sitr != db.end()) {
         eosio::print("\n");
@@ -527,6 +677,16 @@ bool evm_contract::gc(uint32_t max) {
         ++sitr;
         ++cnt;
     }
+    storage_v2_table slots(_self, *account_id);
+    for(const auto& slot : slots) {
+        auto key = slot.key.extract_as_byte_array();
+        eosio::print("\n");
+        eosio::printhex(key.data(), key.size());
+        eosio::print(":");
+        eosio::printhex(slot.value.data(), slot.value.size());
+        eosio::print("\n");
+        ++cnt;
+    }
 
     eosio::print(" = ", cnt, "\n");
 }
@@ -544,21 +704,40 @@ bool evm_contract::gc(uint32_t max) {
         eosio::print("\n");
     };
 
-    account_table accounts(_self, _self.value);
-    auto itr = accounts.begin();
-    eosio::print("DUMPALL start\n");
-    while( itr != accounts.end() ) {
+    auto print_slots = [&](uint64_t storage_id) {
+        storage_v2_table slots(_self, storage_id);
+        for(const auto& slot : slots) {
+            auto key = slot.key.extract_as_byte_array();
+            eosio::print("    ");
+            eosio::printhex(key.data(), key.size());
+            eosio::print(":");
+            eosio::printhex(slot.value.data(), slot.value.size());
+            eosio::print("\n");
+        }
+    };
+
+    auto print_account = [&](uint64_t id, const uint8_t* address, size_t size) {
         eosio::print("  account:");
-        eosio::printhex(itr->eth_address.data(), itr->eth_address.size());
+        eosio::printhex(address, size);
         eosio::print("\n");
-        storage_table db(_self, itr->id);
+        storage_table db(_self, id);
         auto sitr = db.begin();
         while( sitr != db.end() ) {
             print_store( sitr );
             sitr++;
         }
-        
-        itr++;
+        print_slots( id );
+    };
+
+    eosio::print("DUMPALL start\n");
+    account_v2_table accounts(_self, _self.value);
+    for( const auto& row : accounts ) {
+        auto address = row.eth_address.extract_as_byte_array();
+        print_account( row.id, address.data(), address.size() );
+    }
+    account_table legacy(_self, _self.value);
+    for( const auto& row : legacy ) {
+        print_account( row.id, (const uint8_t*)row.eth_address.data(), row.eth_address.size() );
     }
     eosio::print("  gc:");
     gc_store_table gc(_self, _self.value);
@@ -573,6 +752,7 @@ bool evm_contract::gc(uint32_t max) {
             print_store( sitr );
             ++sitr;
         }
+        print_slots( i->storage_id );
 
         ++i;
     }
@@ -586,14 +766,11 @@ bool evm_contract::gc(uint32_t max) {
 
     eosio::require_auth(get_self());
 
-    account_table accounts(_self, _self.value);
-    auto itr = accounts.begin();
-    eosio::print("CLEAR start\n");
-    while( itr != accounts.end() ) {
+    auto clear_storage = [&](uint64_t id, const uint8_t* address, size_t size) {
         eosio::print("  account:");
-        eosio::printhex(itr->eth_address.data(), itr->eth_address.size());
+        eosio::printhex(address, size);
         eosio::print("\n");
-        storage_table db(_self, itr->id);
+        storage_table db(_self, id);
         auto sitr = db.begin();
         while( sitr != db.end() ) {
             eosio::print("    ");
@@ -604,10 +781,30 @@ bool evm_contract::gc(uint32_t max) {
             sitr = db.erase(sitr);
         }
 
+        storage_v2_table slots(_self, id);
+        auto vitr = slots.begin();
+        while( vitr != slots.end() ) {
+            vitr = slots.erase(vitr);
+        }
+
         auto db_size = std::distance(db.cbegin(), db.cend());
         eosio::print("db size:", uint64_t(db_size), "\n");
+    };
+
+    eosio::print("CLEAR start\n");
+    account_v2_table accounts(_self, _self.value);
+    auto itr = accounts.begin();
+    while( itr != accounts.end() ) {
+        auto address = itr->eth_address.extract_as_byte_array();
+        clear_storage(itr->id, address.data(), address.size());
         itr = accounts.erase(itr);
     }
+    account_table legacy(_self, _self.value);
+    auto litr = legacy.begin();
+    while( litr != legacy.end() ) {
+        clear_storage(litr->id, (const uint8_t*)litr->eth_address.data(), litr->eth_address.size());
+        litr = legacy.erase(litr);
+    }
 
     account_code_table codes(_self, _self.value);
     auto itrc = codes.begin();
@@ -617,7 +814,7 @@ bool evm_contract::gc(uint32_t max) {
 
     gc(std::numeric_limits<uint32_t>::max());
 
-    auto account_size = std::distance(accounts.cbegin(), accounts.cend());
+    auto account_size = std::distance(accounts.cbegin(), accounts.cend()) + std::distance(legacy.cbegin(), legacy.cend());
     eosio::print("accounts size:", uint64_t(account_size), "\n");
 
     eosio::print("CLEAR end\n");
@@ -679,13 +876,23 @@ bool evm_contract::gc(uint32_t max) {
 
     eosio::require_auth(get_self());
 
+    account_v2_table accounts_v2(_self, _self.value);
+    auto inx_v2 = accounts_v2.get_index<"by.address"_n>();
+    if(auto itr = inx_v2.find(make_key(addy)); itr != inx_v2.end()) {
+        inx_v2.modify(itr, eosio::same_payer, [&](auto& row){
+            row.set_balance(intx::be::store<uint256be>(to_uint256(bal)));
+        });
+        return;
+    }
+
+    // New accounts are written in the legacy layout so that tests can exercise migrateacct
     account_table accounts(_self, _self.value);
     auto inx = accounts.get_index<"by.address"_n>();
     auto itr = inx.find(make_key(addy));
 
     if(itr == inx.end()) {
         accounts.emplace(get_self(), [&](auto& row){
-            row.id = accounts.available_primary_key();;
+            row.id = std::max(accounts.available_primary_key(), accounts_v2.available_primary_key());
             row.code_id = std::nullopt;
             row.eth_address = addy;
             row.balance = bal;
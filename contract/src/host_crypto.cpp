@@ -0,0 +1,48 @@
+#include <cstring>
+#include <evm_runtime/host_crypto.hpp>
+#include <evm_runtime/intrinsics.hpp>
+#include <silkworm/rlp/encode.hpp>
+
+namespace evm_runtime {
+
+#ifdef WITH_HOST_CRYPTO
+ethash::hash256 keccak256(const void* data, size_t size) {
+    ethash::hash256 res;
+    eosio::internal_use_do_not_use::sha3(reinterpret_cast<const char*>(data), size,
+                                         reinterpret_cast<char*>(res.bytes), sizeof(res.bytes), 1);
+    return res;
+}
+#endif
+
+void recover_sender(silkworm::Transaction& tx) {
+#ifdef WITH_HOST_CRYPTO
+    if (tx.from.has_value()) {
+        return;
+    }
+
+    silkworm::Bytes rlp;
+    silkworm::rlp::encode(rlp, tx, /*for_signing=*/true, /*wrap_eip2718_into_string=*/false);
+    const auto digest = keccak256(rlp.data(), rlp.size());
+
+    // k1_recover takes the recovery id as 27 + y parity followed by r and s
+    uint8_t signature[65];
+    signature[0] = 27 + (tx.odd_y_parity ? 1 : 0);
+    intx::be::unsafe::store(signature + 1, tx.r);
+    intx::be::unsafe::store(signature + 33, tx.s);
+
+    uint8_t pub[65];
+    if (eosio::internal_use_do_not_use::k1_recover(reinterpret_cast<const char*>(signature), sizeof(signature),
+                                                   reinterpret_cast<const char*>(digest.bytes), sizeof(digest.bytes),
+                                                   reinterpret_cast<char*>(pub), sizeof(pub)) == 0 && pub[0] == 4) {
+        // The address is the tail of the hash of the uncompressed key, without its prefix byte
+        const auto hash = keccak256(pub + 1, sizeof(pub) - 1);
+        evmc::address from;
+        std::memcpy(from.bytes, hash.bytes + 12, sizeof(from.bytes));
+        tx.from = from;
+        return;
+    }
+#endif
+    tx.recover_sender();
+}
+
+}  // namespace evm_runtime
@@ -0,0 +1,195 @@
+// Precompiled contracts of the EVM contract, compiled in place of silkworm/execution/precompiled.cpp.
+//
+// Built with WITH_HOST_CRYPTO the precompiles backed by a Leap crypto primitive are routed to the host function.
+// Silkworm's Wasm implementations are kept under a wasm_ prefix and are only used for the inputs the host function
+// rejects or that would hit its block production limits, so the results are the same in both builds.
+#include <silkworm/execution/precompiled.hpp>
+
+#ifdef WITH_HOST_CRYPTO
+#define ecrec_run    wasm_ecrec_run
+#define sha256_run   wasm_sha256_run
+#define expmod_run   wasm_expmod_run
+#define bn_add_run   wasm_bn_add_run
+#define bn_mul_run   wasm_bn_mul_run
+#define snarkv_run   wasm_snarkv_run
+#define blake2_f_run wasm_blake2_f_run
+#endif
+
+#include <silkworm/execution/precompiled.cpp>
+
+#ifdef WITH_HOST_CRYPTO
+#undef ecrec_run
+#undef sha256_run
+#undef expmod_run
+#undef bn_add_run
+#undef bn_mul_run
+#undef snarkv_run
+#undef blake2_f_run
+
+#include <eosio/crypto.hpp>
+#include <evm_runtime/host_crypto.hpp>
+#include <evm_runtime/intrinsics.hpp>
+
+namespace silkworm::precompiled {
+
+namespace host = eosio::internal_use_do_not_use;
+
+static const char* as_chars(const uint8_t* p) { return reinterpret_cast<const char*>(p); }
+
+std::optional<Bytes> ecrec_run(ByteView input) noexcept {
+    static constexpr size_t kInputLen{128};
+    Bytes d{input};
+    if (d.length() < kInputLen) {
+        d.resize(kInputLen, '\0');
+    }
+
+    const auto v{intx::be::unsafe::load<intx::uint256>(&d[32])};
+    const auto r{intx::be::unsafe::load<intx::uint256>(&d[64])};
+    const auto s{intx::be::unsafe::load<intx::uint256>(&d[96])};
+
+    const bool homestead{false};  // See EIP-2
+    if (!ecdsa::is_valid_signature(r, s, homestead)) {
+        return Bytes{};
+    }
+
+    const std::optional<ecdsa::YParityAndChainId> parity_and_id{ecdsa::v_to_y_parity_and_chain_id(v)};
+    if (parity_and_id == std::nullopt || parity_and_id->chain_id != std::nullopt) {
+        return Bytes{};
+    }
+
+    uint8_t signature[65];
+    signature[0] = 27 + (parity_and_id->odd ? 1 : 0);
+    std::memcpy(signature + 1, &d[64], 64);
+
+    uint8_t key[65];
+    if (host::k1_recover(as_chars(signature), sizeof(signature), as_chars(&d[0]), 32,
+                         reinterpret_cast<char*>(key), sizeof(key)) != 0 || key[0] != 4u) {
+        return wasm_ecrec_run(input);
+    }
+
+    // Ignore the first byte of the public key
+    const ethash::hash256 hash{evm_runtime::keccak256(key + 1, sizeof(key) - 1)};
+    Bytes out(32, '\0');
+    std::memcpy(&out[12], &hash.bytes[12], 32 - 12);
+    return out;
+}
+
+std::optional<Bytes> sha256_run(ByteView input) noexcept {
+    const auto hash{eosio::sha256(as_chars(input.data()), input.length()).extract_as_byte_array()};
+    return Bytes{hash.begin(), hash.end()};
+}
+
+// Mirrors the limits Leap enforces on mod_exp while producing blocks, which fail the whole transaction instead of
+// returning an error
+static bool host_mod_exp_allowed(uint64_t base_len, uint64_t exponent_len, uint64_t modulus_len) noexcept {
+    auto ceil_log2 = [](uint64_t n) -> uint64_t { return n <= 1 ? 0 : 64 - __builtin_clzll(n - 1); };
+    const uint64_t base_modulus_len{std::max(base_len, modulus_len)};
+    if (base_modulus_len > std::numeric_limits<uint32_t>::max() || exponent_len > base_modulus_len) {
+        return false;
+    }
+    return 5 * ceil_log2(exponent_len) + 8 * ceil_log2(base_modulus_len) <= 106;
+}
+
+std::optional<Bytes> expmod_run(ByteView input) noexcept {
+    const ByteView original{input};
+
+    Bytes buffer;
+    input = right_pad(input, 3 * 32, buffer);
+
+    uint64_t base_len{endian::load_big_u64(&input[24])};
+    input.remove_prefix(32);
+
+    uint64_t exponent_len{endian::load_big_u64(&input[24])};
+    input.remove_prefix(32);
+
+    uint64_t modulus_len{endian::load_big_u64(&input[24])};
+    input.remove_prefix(32);
+
+    if (modulus_len == 0) {
+        return Bytes{};
+    }
+
+    if (!host_mod_exp_allowed(base_len, exponent_len, modulus_len)) {
+        return wasm_expmod_run(original);
+    }
+
+    input = right_pad(input, base_len + exponent_len + modulus_len, buffer);
+    const uint8_t* base{input.data()};
+    const uint8_t* exponent{base + base_len};
+    const uint8_t* modulus{exponent + exponent_len};
+
+    Bytes out(modulus_len, '\0');
+    if (std::all_of(modulus, modulus + modulus_len, [](uint8_t b) { return b == 0; })) {
+        return out;
+    }
+
+    if (host::mod_exp(as_chars(base), base_len, as_chars(exponent), exponent_len, as_chars(modulus), modulus_len,
+                      reinterpret_cast<char*>(out.data()), out.size()) != 0) {
+        return wasm_expmod_run(original);
+    }
+    return out;
+}
+
+std::optional<Bytes> bn_add_run(ByteView input) noexcept {
+    Bytes buffer;
+    const ByteView padded{right_pad(input, 128, buffer)};
+
+    Bytes out(64, '\0');
+    if (host::alt_bn128_add(as_chars(padded.data()), 64, as_chars(padded.data() + 64), 64,
+                            reinterpret_cast<char*>(out.data()), out.size()) != 0) {
+        return wasm_bn_add_run(input);
+    }
+    return out;
+}
+
+std::optional<Bytes> bn_mul_run(ByteView input) noexcept {
+    Bytes buffer;
+    const ByteView padded{right_pad(input, 96, buffer)};
+
+    Bytes out(64, '\0');
+    if (host::alt_bn128_mul(as_chars(padded.data()), 64, as_chars(padded.data() + 64), 32,
+                            reinterpret_cast<char*>(out.data()), out.size()) != 0) {
+        return wasm_bn_mul_run(input);
+    }
+    return out;
+}
+
+std::optional<Bytes> snarkv_run(ByteView input) noexcept {
+    if (input.size() % kSnarkvStride != 0) {
+        return std::nullopt;
+    }
+
+    Bytes out(32, '\0');
+    if (input.empty()) {
+        out[31] = 1;
+        return out;
+    }
+
+    const int32_t res{host::alt_bn128_pair(as_chars(input.data()), input.size())};
+    if (res != 0 && res != 1) {
+        return wasm_snarkv_run(input);
+    }
+    out[31] = res == 0 ? 1 : 0;
+    return out;
+}
+
+std::optional<Bytes> blake2_f_run(ByteView input) noexcept {
+    if (input.size() != 213) {
+        return std::nullopt;
+    }
+    uint8_t f{input[212]};
+    if (f != 0 && f != 1) {
+        return std::nullopt;
+    }
+
+    Bytes out(8 * 8, '\0');
+    if (host::blake2_f(endian::load_big_u32(input.data()), as_chars(input.data() + 4), 8 * 8,
+                       as_chars(input.data() + 68), 16 * 8, as_chars(input.data() + 196), 8,
+                       as_chars(input.data() + 204), 8, f, reinterpret_cast<char*>(out.data()), out.size()) != 0) {
+        return wasm_blake2_f_run(input);
+    }
+    return out;
+}
+
+}  // namespace silkworm::precompiled
+#endif
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <evm_runtime/tables.hpp>
 #include <evm_runtime/state.hpp>
@@ -7,77 +9,262 @@
 
 namespace evm_runtime {
 
-std::optional<Account> state::read_account(const evmc::address& address) const noexcept {    
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
+namespace db = eosio::internal_use_do_not_use;
 
-    if (itr == inx.end()) {
-        return {};
+// The account_code rows and their by.codehash index are read through the database intrinsics directly, see
+// load_code and code_hash_of
+static constexpr name account_code_name = "accountcode"_n;
+static constexpr name codehash_index{account_code_name.value & 0xFFFFFFFFFFFFFFF0ULL};
+
+char* code_arena::allocate(size_t size) {
+    if (_chunks.empty() || _capacity - _used < size) {
+        _capacity = std::max(size, chunk_size);
+        _chunks.emplace_back(new char[_capacity]);
+        _used = 0;
     }
-    
-    addr2id[address] = itr->id;
+    char* p = _chunks.back().get() + _used;
+    _used += size;
+    return p;
+}
 
-    evmc::bytes32 code_hash;
-    if (itr->code_id) {
+account_v2_table& state::accounts() const {
+    if (!_accounts) {
+        _accounts.emplace(_self, _self.value);
+    }
+    return *_accounts;
+}
+
+account_table& state::legacy_accounts() const {
+    if (!_legacy_accounts) {
+        _legacy_accounts.emplace(_self, _self.value);
+    }
+    return *_legacy_accounts;
+}
+
+bool state::has_legacy_accounts() const {
+    if (!_has_legacy_accounts) {
+        _has_legacy_accounts = legacy_accounts().begin() != legacy_accounts().end();
+    }
+    return *_has_legacy_accounts;
+}
+
+std::optional<uint64_t> state::next_account(uint64_t id) const {
+    std::optional<uint64_t> res;
+    if (auto itr = accounts().lower_bound(id); itr != accounts().end()) {
+        res = itr->id;
+    }
+    if (has_legacy_accounts()) {
+        if (auto itr = legacy_accounts().lower_bound(id); itr != legacy_accounts().end() && (!res || itr->id < *res)) {
+            res = itr->id;
+        }
+    }
+    return res;
+}
+
+storage_table& state::storage_of(uint64_t account_id) const {
+    auto itr = _storages.find(account_id);
+    if (itr == _storages.end()) {
+        itr = _storages.try_emplace(account_id, _self, account_id).first;
+    }
+    return itr->second;
+}
+
+storage_v2_table& state::slots_of(uint64_t account_id) const {
+    auto itr = _slots.find(account_id);
+    if (itr == _slots.end()) {
+        itr = _slots.try_emplace(account_id, _self, account_id).first;
+    }
+    return itr->second;
+}
+
+bool state::has_legacy_storage(uint64_t account_id) const {
+    auto itr = _legacy_storage.find(account_id);
+    if (itr == _legacy_storage.end()) {
+        auto& db = storage_of(account_id);
+        itr = _legacy_storage.emplace(account_id, db.begin() != db.end()).first;
+    }
+    return itr->second;
+}
+
+cached_account* state::find_account(const evmc::address& address) const {
+    auto cached = addr2account.find(address);
+    if (cached == addr2account.end()) {
+        std::optional<cached_account> entry;
+        const auto key = make_key(address);
+        auto inx = accounts().get_index<"by.address"_n>();
+        ++stats.account.read;
+        if (auto itr = inx.find(key); itr != inx.end()) {
+            entry.emplace(cached_account{*itr, false});
+        } else if (has_legacy_accounts()) {
+            auto legacy_inx = legacy_accounts().get_index<"by.address"_n>();
+            if (auto litr = legacy_inx.find(key); litr != legacy_inx.end()) {
+                entry.emplace(cached_account{account_v2::from_legacy(*litr), true});
+            }
+        }
+        cached = addr2account.emplace(address, std::move(entry)).first;
+    }
+    return cached->second ? &*cached->second : nullptr;
+}
+
+const account_v2& state::create_account(const evmc::address& address, uint64_t nonce, const uint256be& balance,
+                                        std::optional<uint64_t> code_id) {
+    auto& table = accounts();
+    account_v2 row;
+    // Ids are shared with the legacy table as they are the scope of the account storage
+    row.id = table.available_primary_key();
+    if (has_legacy_accounts()) {
+        row.id = std::max(row.id, legacy_accounts().available_primary_key());
+    }
+    row.set_address(address);
+    row.nonce = nonce;
+    row.set_balance(balance);
+    row.set_code_id(code_id);
+    table.emplace(_ram_payer, [&](auto& r){
+        r = row;
+    });
+    ++stats.account.create;
+    return addr2account[address].emplace(cached_account{row, false}).row;
+}
+
+void state::write_account(cached_account& cached) {
+    auto& table = accounts();
+    if (cached.legacy) {
+        auto& legacy = legacy_accounts();
+        legacy.erase(legacy.get(cached.row.id, "legacy account not found"));
+        table.emplace(_ram_payer, [&](auto& r){
+            r = cached.row;
+        });
+        cached.legacy = false;
+    } else {
+        table.modify(table.get(cached.row.id, "account not found"), eosio::same_payer, [&](auto& r){
+            r = cached.row;
+        });
+    }
+    ++stats.account.update;
+}
+
+void state::remove_account(const evmc::address& address, cached_account& cached) {
+    const auto& row = cached.row;
+    // add to garbage collection table for later removal
+    gc_store_table gc(_self, _self.value);
+    gc.emplace(_ram_payer, [&](auto& r){
+        r.id = gc.available_primary_key();
+        r.storage_id = row.id;
+    });
+    // Remove code if necessary
+    if (auto code_id = row.get_code_id()) {
         account_code_table codes(_self, _self.value);
-        auto citr = codes.find(itr->code_id.value());
-        if (citr != codes.end()) {
-            code_hash = to_bytes32(citr->code_hash);
-            addr2code[code_hash] = citr->code;
+        const auto& itrc = codes.get(*code_id, "code not found");
+        if(itrc.ref_count-1) {
+            codes.modify(itrc, eosio::same_payer, [&](auto& r){
+                r.ref_count--;
+            });
         } else {
-            // Should not reach here! 
-            // Return empty hash for robustness.
-            code_hash = silkworm::kEmptyHash;
+            codes.erase(itrc);
         }
+    }
+    _storages.erase(row.id);
+    _slots.erase(row.id);
+    _legacy_storage.erase(row.id);
+    if (cached.legacy) {
+        legacy_accounts().erase(legacy_accounts().get(row.id, "legacy account not found"));
     } else {
-        code_hash = silkworm::kEmptyHash;
+        accounts().erase(accounts().get(row.id, "account not found"));
     }
+    addr2account[address] = std::nullopt;
+}
 
-    return Account{itr->nonce, intx::be::load<uint256>(itr->get_balance()), code_hash, 0};
+std::optional<Account> state::read_account(const evmc::address& address) const noexcept {
+    const auto* cached = find_account(address);
+    if (!cached) {
+        return {};
+    }
+    const auto& row = cached->row;
+
+    evmc::bytes32 code_hash = silkworm::kEmptyHash;
+    if (auto code_id = row.get_code_id()) {
+        // Only the code hash is needed here, the code itself is loaded if and when the EVM asks for it.
+        // Should the code row be missing, the empty hash is returned for robustness.
+        if (auto hash = code_hash_of(*code_id)) {
+            code_hash = *hash;
+        }
+    }
+
+    return Account{row.nonce, intx::be::load<uint256>(row.get_balance()), code_hash, 0};
 }
 
 ByteView state::read_code(const evmc::bytes32& code_hash) const noexcept {
     
-    if(addr2code.find(code_hash) != addr2code.end()) {
-        const auto& code = addr2code[code_hash];
-        return ByteView{(const uint8_t*)code.data(), code.size()};
+    if(auto itr = addr2code.find(code_hash); itr != addr2code.end()) {
+        return itr->second;
     }
-    
-    account_code_table codes(_self, _self.value);
-    auto inx = codes.get_index<"by.codehash"_n>();
-    auto itr = inx.find(make_key(code_hash));
-    
-    if (itr == inx.end() || itr->code.size() == 0) {
+
+    std::optional<uint64_t> code_id;
+    if(auto itr = _code_ids.find(code_hash); itr != _code_ids.end()) {
+        code_id = itr->second;
+    } else {
+        auto key = make_key(code_hash).extract_as_word_array<uint128_t>();
+        uint64_t primary = 0;
+        if(db::db_idx256_find_secondary(_self.value, _self.value, codehash_index.value, key.data(), key.size(), primary) >= 0) {
+            code_id = primary;
+        }
+    }
+
+    ByteView code = code_id ? load_code(*code_id) : ByteView{};
+    if (code.empty()) {
         return ByteView{};
     }
 
-    addr2code[code_hash] = itr->code;
-    const auto& code = addr2code[code_hash];
-    return ByteView{(const uint8_t*)code.data(), code.size()};
+    addr2code.emplace(code_hash, code);
+    return code;
+}
+
+std::optional<evmc::bytes32> state::code_hash_of(uint64_t code_id) const {
+    std::array<uint128_t, 2> key;
+    if (db::db_idx256_find_primary(_self.value, _self.value, codehash_index.value, key.data(), key.size(), code_id) < 0) {
+        return {};
+    }
+    evmc::bytes32 code_hash;
+    const auto hash = checksum256{key}.extract_as_byte_array();
+    std::copy(hash.begin(), hash.end(), code_hash.bytes);
+    _code_ids.emplace(code_hash, code_id);
+    return code_hash;
+}
+
+ByteView state::load_code(uint64_t code_id) const {
+    // The row is copied once by the host into the arena and the code is served from there, instead of going through
+    // a multi_index object holding its own copy of the code
+    auto itr = db::db_find_i64(_self.value, _self.value, account_code_name.value, code_id);
+    if (itr < 0) {
+        return ByteView{};
+    }
+    const auto size = db::db_get_i64(itr, nullptr, 0);
+    char* buffer = _code_arena.allocate(size);
+    db::db_get_i64(itr, buffer, size);
+
+    datastream<const char*> ds(buffer, size);
+    uint64_t id;
+    uint32_t ref_count;
+    unsigned_int code_size;
+    ds >> id >> ref_count >> code_size;
+    const ByteView code{(const uint8_t*)ds.pos(), code_size.value};
+    return code;
 }
 
 evmc::bytes32 state::read_storage(const evmc::address& address, uint64_t incarnation,
                                           const evmc::bytes32& location) const noexcept {
-    
-    uint64_t account_id = 0;
-    if(addr2id.find(address) == addr2id.end()) {
-        account_table accounts(_self, _self.value);
-        auto inx = accounts.get_index<"by.address"_n>();
-        auto itr = inx.find(make_key(address));
-        ++stats.account.read;
-        if (itr == inx.end()) return {};
-        addr2id[address] = itr->id;
-    }
+    const auto* cached = find_account(address);
+    if (!cached) return {};
+    const auto account_id = cached->row.id;
 
-    account_id = addr2id[address];
+    auto& slots = slots_of(account_id);
+    auto itr = slots.find(storage_v2::id_of(location));
+    ++stats.storage.read;
+    if(itr != slots.end() && itr->holds(location)) return itr->get_value();
 
-    storage_table db(_self, account_id);
-    auto inx2 = db.get_index<"by.key"_n>();
+    if(!has_legacy_storage(account_id)) return {};
+    auto inx2 = storage_of(account_id).get_index<"by.key"_n>();
     auto itr2 = inx2.find(make_key(location));
-    ++stats.storage.read;
-    
     if(itr2 == inx2.end()) return {};
 
     evmc::bytes32 res;
@@ -97,73 +284,38 @@ void state::update_account(const evmc::address& address, std::optional<Account>
 
     const bool equal{current == initial};
     if(equal) return;
-    
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
-
-    auto emplace = [&](auto& row) {
-        row.id = accounts.available_primary_key();
-        row.eth_address = to_bytes(address);
-        row.nonce = current->nonce;
-        row.balance = to_bytes(current->balance);
-        // Codes are not supposed to changed in this call.
-        row.code_id = std::nullopt;
-    };
-
-    auto update = [&](auto& row) {
-        row.nonce = current->nonce;
-        row.balance = to_bytes(current->balance);
-        // Codes are not supposed to changed in this call.
-    };
-
-    auto remove_account = [&](auto& itr) {
-        storage_table db(_self, itr->id);
-        // add to garbage collection table for later removal
-        gc_store_table gc(_self, _self.value);
-        gc.emplace(_ram_payer, [&](auto& row){
-            row.id = gc.available_primary_key();
-            row.storage_id = itr->id;
-        });
-        // Remove code if necessary
-        if (itr->code_id) {
-            account_code_table codes(_self, _self.value);
-            const auto& itrc = codes.get(itr->code_id.value(), "code not found");
-            if(itrc.ref_count-1) {
-                codes.modify(itrc, eosio::same_payer, [&](auto& row){
-                    row.ref_count--;
-                });
-            } else {
-                codes.erase(itrc);
-            }
-        }
-        accounts.erase(*itr);
-    };
 
+    auto* cached = find_account(address);
 
     if (current.has_value()) {
-        if (itr == inx.end()) {
-            accounts.emplace(_ram_payer, emplace);
-            ++stats.account.create;
+        const auto balance = intx::be::store<uint256be>(current->balance);
+        if (!cached) {
+            create_account(address, current->nonce, balance);
         } else {
             if( initial && initial->incarnation != current->incarnation ) {
-                remove_account(itr);
-                accounts.emplace(_ram_payer, emplace);
+                remove_account(address, *cached);
+                create_account(address, current->nonce, balance);
             } else {
-                accounts.modify(*itr, eosio::same_payer, update);
-                ++stats.account.update;
+                cached->row.nonce = current->nonce;
+                cached->row.set_balance(balance);
+                // Codes are not supposed to changed in this call.
+                write_account(*cached);
             }
         }
     } else {
-        if(itr != inx.end()) {
-            remove_account(itr);
+        if(cached) {
+            remove_account(address, *cached);
             ++stats.account.remove;
         }
     }
 }
 
 bool state::gc(uint32_t max) {
+    gc_state_singleton progress(_self, _self.value);
+    auto gcs = progress.get_or_default();
+    const auto erased_before = gcs.rows_erased;
+    const auto collected_before = gcs.collected;
+
     gc_store_table gc(_self, _self.value);
     auto i = gc.begin();
     while( max && i != gc.end() ) {
@@ -171,14 +323,96 @@ bool state::gc(uint32_t max) {
         auto sitr = db.begin();
         while( max && sitr != db.end() ) {
             sitr = db.erase(sitr);
+            ++gcs.rows_erased;
+            --max;
+        }
+        storage_v2_table slots(_self, i->storage_id);
+        auto vitr = slots.begin();
+        while( max && vitr != slots.end() ) {
+            vitr = slots.erase(vitr);
+            ++gcs.rows_erased;
             --max;
         }
         if( !max ) break;
         i = gc.erase(i);
+        ++gcs.collected;
         --max;
     }
 
-    return gc.begin() == gc.end();
+    if( gcs.rows_erased != erased_before || gcs.collected != collected_before ) {
+        progress.set(gcs, _self);
+    }
+    return i == gc.end();
+}
+
+void state::gc_pushed(uint32_t txs) {
+    gc_state_singleton progress(_self, _self.value);
+    if( !progress.exists() ) return;
+    const auto rows_per_tx = progress.get().rows_per_tx;
+    if( rows_per_tx ) {
+        gc(static_cast<uint32_t>(std::min<uint64_t>(uint64_t(rows_per_tx) * txs, std::numeric_limits<uint32_t>::max())));
+    }
+}
+
+bool state::migrate_storage(uint32_t max) {
+    storage_migration_singleton progress(_self, _self.value);
+    auto cursor = progress.get_or_default();
+
+    // Accounts are walked by id across the compact and the legacy account tables
+    auto account_id = next_account(cursor.next_account);
+    while( account_id ) {
+        auto& db = storage_of(*account_id);
+        auto& slots = slots_of(*account_id);
+        auto sitr = db.lower_bound(cursor.next_row);
+        while( max && sitr != db.end() ) {
+            auto location = to_bytes32(sitr->key);
+            auto id = storage_v2::id_of(location);
+            // A slot sharing its low 64 bits with a migrated one stays in the legacy table
+            if( slots.find(id) == slots.end() ) {
+                slots.emplace(_ram_payer, [&](auto& r){
+                    r.id = id;
+                    r.key = make_key(location);
+                    r.set_value(to_bytes32(sitr->value));
+                });
+                sitr = db.erase(sitr);
+            } else {
+                ++sitr;
+            }
+            --max;
+        }
+        if( sitr != db.end() ) {
+            cursor.next_row = sitr->id;
+            break;
+        }
+        _legacy_storage.erase(*account_id);
+        cursor.next_account = *account_id + 1;
+        cursor.next_row = 0;
+        account_id = next_account(cursor.next_account);
+        if( !max ) break;
+        --max;
+    }
+    progress.set(cursor, _ram_payer);
+
+    return !account_id;
+}
+
+bool state::migrate_accounts(uint32_t max) {
+    // Migrated rows are erased from the legacy table, so the table itself is the resume point
+    auto& legacy = legacy_accounts();
+    auto& table = accounts();
+    auto itr = legacy.begin();
+    while( max && itr != legacy.end() ) {
+        const auto row = account_v2::from_legacy(*itr);
+        table.emplace(_ram_payer, [&](auto& r){
+            r = row;
+        });
+        itr = legacy.erase(itr);
+        --max;
+    }
+    // Cached rows may refer to the legacy table
+    addr2account.clear();
+    _has_legacy_accounts = itr != legacy.end();
+    return itr == legacy.end();
 }
 
 void state::update_account_code(const evmc::address& address, uint64_t, const evmc::bytes32& code_hash, ByteView code) {
@@ -202,76 +436,80 @@ void state::update_account_code(const evmc::address& address, uint64_t, const ev
         code_id = itrc->id;
     }
     
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
-    if( itr != inx.end() ) {
-        accounts.modify(*itr, eosio::same_payer, [&](auto& row){
-            row.code_id = code_id;
-        });
-        ++stats.account.update;
+    if( auto* cached = find_account(address) ) {
+        cached->row.set_code_id(code_id);
+        write_account(*cached);
     } else {
-        accounts.emplace(_ram_payer, [&](auto& row){
-            row.id = accounts.available_primary_key();;
-            row.eth_address = to_bytes(address);
-            row.nonce = 0;
-            row.code_id = code_id;
-        });
-        ++stats.account.create;
+        create_account(address, 0, {}, code_id);
     }
 }
 
 void state::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
                                    const evmc::bytes32& initial, const evmc::bytes32& current) {
     
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
-
-    if (is_zero(current)) {
-        if(itr == inx.end()) return;
-        storage_table db(_self, itr->id);
-        auto inx2 = db.get_index<"by.key"_n>();
-        auto itr2 = inx2.find(make_key(location));
-        ++stats.storage.read;
-        if(itr2 == inx2.end()) return;
-        db.erase(*itr2);
-        ++stats.storage.remove;
-    } else {
-        uint64_t table_id;
-        if(itr == inx.end()){
-            accounts.emplace(_ram_payer, [&](auto& row){
-                table_id = accounts.available_primary_key();
-                row.id = table_id;
-                row.eth_address = to_bytes(address);
-                row.nonce = 0;
-                row.code_id = std::nullopt;
-            });
-            ++stats.account.read;
+    const auto* cached = find_account(address);
+    const bool erase = is_zero(current);
+
+    const account_v2* row = cached ? &cached->row : nullptr;
+    if(!row) {
+        if(erase) return;
+        row = &create_account(address, 0, {});
+    }
+
+    auto& slots = slots_of(row->id);
+    auto itr = slots.find(storage_v2::id_of(location));
+    ++stats.storage.read;
+    if(itr != slots.end() && itr->holds(location)) {
+        if(erase) {
+            slots.erase(itr);
+            ++stats.storage.remove;
         } else {
-            table_id = itr->id;
+            slots.modify(itr, eosio::same_payer, [&](auto& r){
+                r.set_value(current);
+            });
+            ++stats.storage.update;
         }
+        return;
+    }
 
-        storage_table db(_self, table_id);
+    if(has_legacy_storage(row->id)) {
+        auto& db = storage_of(row->id);
         auto inx2 = db.get_index<"by.key"_n>();
         auto itr2 = inx2.find(make_key(location));
-        ++stats.storage.read;
-        if(itr2 == inx2.end()) {
-            db.emplace(_ram_payer, [&](auto& row){
-                row.id = db.available_primary_key();
-                row.key = to_bytes(location);
-                row.value = to_bytes(current);
-            });
-            ++stats.storage.create;
-        } else {
-            db.modify(*itr2, eosio::same_payer, [&](auto& row){
-                row.value = to_bytes(current);
-            });
-            ++stats.storage.update;
+        if(itr2 != inx2.end()) {
+            if(erase) {
+                db.erase(*itr2);
+                _legacy_storage.erase(row->id);
+                ++stats.storage.remove;
+            } else {
+                db.modify(*itr2, eosio::same_payer, [&](auto& r){
+                    r.value = to_bytes(current);
+                });
+                ++stats.storage.update;
+            }
+            return;
         }
     }
+
+    if(erase) return;
+
+    if(itr == slots.end()) {
+        slots.emplace(_ram_payer, [&](auto& r){
+            r.id = storage_v2::id_of(location);
+            r.key = make_key(location);
+            r.set_value(current);
+        });
+    } else {
+        // The primary key is taken by another slot, keep this one in the legacy table
+        auto& db = storage_of(row->id);
+        db.emplace(_ram_payer, [&](auto& r){
+            r.id = db.available_primary_key();
+            r.key = to_bytes(location);
+            r.value = to_bytes(current);
+        });
+        _legacy_storage[row->id] = true;
+    }
+    ++stats.storage.create;
 }
 
 std::optional<BlockHeader> state::read_header(uint64_t block_number,
@@ -45,6 +45,15 @@ struct partial_account_table_row
    bytes balance;
 };
 
+struct account_v2_table_row
+{
+   uint64_t id;
+   fc::ripemd160 eth_address;
+   uint64_t nonce;
+   fc::sha256 balance;
+   uint64_t code_id;
+};
+
 struct storage_table_row
 {
    uint64_t id;
@@ -52,11 +61,20 @@ struct storage_table_row
    bytes value;
 };
 
+struct storage_v2_table_row
+{
+   uint64_t id;
+   fc::sha256 key;
+   bytes value;
+};
+
 } // namespace evm_test
 
 FC_REFLECT(evm_test::vault_balance_row, (owner)(balance)(dust))
 FC_REFLECT(evm_test::partial_account_table_row, (id)(eth_address)(nonce)(balance))
+FC_REFLECT(evm_test::account_v2_table_row, (id)(eth_address)(nonce)(balance)(code_id))
 FC_REFLECT(evm_test::storage_table_row, (id)(key)(value))
+FC_REFLECT(evm_test::storage_v2_table_row, (id)(key)(value))
 
 namespace evm_test {
 
@@ -243,7 +261,7 @@ basic_evm_tester::generate_tx(const evmc::address& to, const intx::uint256& valu
    };
 }
 
-void basic_evm_tester::pushtx(const silkworm::Transaction& trx, name miner)
+transaction_trace_ptr basic_evm_tester::pushtx(const silkworm::Transaction& trx, name miner)
 {
    silkworm::Bytes rlp;
    silkworm::rlp::encode(rlp, trx);
@@ -252,7 +270,19 @@ void basic_evm_tester::pushtx(const silkworm::Transaction& trx, name miner)
    rlp_bytes.resize(rlp.size());
    memcpy(rlp_bytes.data(), rlp.data(), rlp.size());
 
-   push_action(evm_account_name, "pushtx"_n, miner, mvo()("miner", miner)("rlptx", rlp_bytes));
+   return push_action(evm_account_name, "pushtx"_n, miner, mvo()("miner", miner)("rlptx", rlp_bytes));
+}
+
+void basic_evm_tester::pushtxs(const std::vector<silkworm::Transaction>& trxs, name miner)
+{
+   std::vector<bytes> rlp_txs;
+   for (const auto& trx : trxs) {
+      silkworm::Bytes rlp;
+      silkworm::rlp::encode(rlp, trx);
+      rlp_txs.emplace_back(rlp.begin(), rlp.end());
+   }
+
+   push_action(evm_account_name, "pushtxs"_n, miner, mvo()("miner", miner)("rlptxs", rlp_txs));
 }
 
 evmc::address basic_evm_tester::deploy_contract(evm_eoa& eoa, evmc::bytes bytecode)
@@ -340,12 +370,38 @@ std::optional<account_object> convert_to_account_object(const partial_account_ta
    };
 }
 
+account_object convert_to_account_object(const account_v2_table_row& row)
+{
+   evmc::address address(0);
+   std::memcpy(address.bytes, row.eth_address.data(), sizeof(address.bytes));
+
+   return account_object{
+      .id = row.id,
+      .address = std::move(address),
+      .nonce = row.nonce,
+      .balance = intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(row.balance.data())),
+   };
+}
+
 bool basic_evm_tester::scan_accounts(std::function<bool(account_object)> visitor) const
 {
    static constexpr eosio::chain::name account_table_name = "account"_n;
+   static constexpr eosio::chain::name account_v2_table_name = "account2"_n;
 
    bool successful = true;
+   bool stopped = false;
 
+   scan_table<account_v2_table_row>(
+      account_v2_table_name, evm_account_name, [&visitor, &stopped](account_v2_table_row&& row) {
+         stopped = visitor(convert_to_account_object(row));
+         return stopped;
+      });
+
+   if (stopped) {
+      return successful;
+   }
+
+   // Rows not migrated yet
    scan_table<partial_account_table_row>(
       account_table_name, evm_account_name, [this, &visitor, &successful](partial_account_table_row&& row) {
          if (auto obj = convert_to_account_object(row)) {
@@ -375,19 +431,17 @@ std::optional<account_object> basic_evm_tester::scan_for_account_by_address(cons
    return result;
 }
 
-std::optional<account_object> basic_evm_tester::find_account_by_address(const evmc::address& address) const
+// Row of `table` whose by.address key is the one of `address`, the secondary index shares the table object of the
+// primary table for 12 character table names
+const chain::key_value_object* find_account_row(const chainbase::database& db,
+                                                eosio::chain::name table,
+                                                const evmc::address& address)
 {
-   static constexpr eosio::chain::name account_table_name = "account"_n;
-
-   std::optional<account_object> result;
-
-   const auto& db = control->db();
-
    const auto* t_id = db.find<chain::table_id_object, chain::by_code_scope_table>(
-      boost::make_tuple(evm_account_name, evm_account_name, account_table_name));
+      boost::make_tuple(basic_evm_tester::evm_account_name, basic_evm_tester::evm_account_name, table));
 
    if (!t_id) {
-      return std::nullopt;
+      return nullptr;
    }
 
    uint8_t address_buffer[32] = {0};
@@ -397,33 +451,63 @@ std::optional<account_object> basic_evm_tester::find_account_by_address(const ev
       boost::make_tuple(t_id->id, fixed_bytes<32>(address_buffer).get_array()));
 
    if (!secondary_row) {
-      return std::nullopt;
+      return nullptr;
    }
 
-   const auto* primary_row = db.find<chain::key_value_object, chain::by_scope_primary>(
+   return db.find<chain::key_value_object, chain::by_scope_primary>(
       boost::make_tuple(t_id->id, secondary_row->primary_key));
+}
 
-   if (!primary_row) {
-      return std::nullopt;
+std::optional<account_object> basic_evm_tester::find_account_by_address(const evmc::address& address) const
+{
+   const auto& db = control->db();
+
+   if (const auto* primary_row = find_account_row(db, "account2"_n, address)) {
+      account_v2_table_row row;
+      fc::datastream<const char*> ds(primary_row->value.data(), primary_row->value.size());
+      fc::raw::unpack(ds, row);
+      return convert_to_account_object(row);
    }
 
-   {
+   if (const auto* primary_row = find_account_row(db, "account"_n, address)) {
       partial_account_table_row row;
       fc::datastream<const char*> ds(primary_row->value.data(), primary_row->value.size());
       fc::raw::unpack(ds, row);
-
-      result = convert_to_account_object(row);
+      return convert_to_account_object(row);
    }
 
-   return result;
+   return std::nullopt;
 }
 
 bool basic_evm_tester::scan_account_storage(uint64_t account_id, std::function<bool(storage_slot)> visitor) const
 {
    static constexpr eosio::chain::name storage_table_name = "storage"_n;
+   static constexpr eosio::chain::name storage_v2_table_name = "storagev2"_n;
 
    bool successful = true;
+   bool stopped = false;
+
+   scan_table<storage_v2_table_row>(
+      storage_v2_table_name, name{account_id}, [&visitor, &successful, &stopped](storage_v2_table_row&& row) {
+         if (row.value.size() > 32) {
+            successful = false;
+            stopped = true;
+            return true;
+         }
+         uint8_t value[32] = {};
+         std::copy(row.value.begin(), row.value.end(), std::end(value) - row.value.size());
+         stopped = visitor(storage_slot{
+            .id = row.id,
+            .key = intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(row.key.data())),
+            .value = intx::be::unsafe::load<intx::uint256>(value)});
+         return stopped;
+      });
+
+   if (stopped) {
+      return successful;
+   }
 
+   // Slots not migrated yet, or whose v2 primary key is taken by another slot
    scan_table<storage_table_row>(
       storage_table_name, name{account_id}, [&visitor, &successful](storage_table_row&& row) {
          if (row.key.size() != 32 || row.value.size() != 32) {
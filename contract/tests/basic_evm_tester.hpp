@@ -162,7 +162,8 @@ public:
    silkworm::Transaction
    generate_tx(const evmc::address& to, const intx::uint256& value, uint64_t gas_limit = 21000) const;
 
-   void pushtx(const silkworm::Transaction& trx, name miner = evm_account_name);
+   transaction_trace_ptr pushtx(const silkworm::Transaction& trx, name miner = evm_account_name);
+   void pushtxs(const std::vector<silkworm::Transaction>& trxs, name miner = evm_account_name);
    evmc::address deploy_contract(evm_eoa& eoa, evmc::bytes bytecode);
 
    void addegress(const std::vector<name>& accounts);
@@ -0,0 +1,116 @@
+#include "basic_evm_tester.hpp"
+
+#include <silkworm/consensus/validation.hpp>
+
+using namespace eosio::testing;
+using namespace evm_test;
+
+struct dryrun_result_row
+{
+   uint8_t status;
+   uint8_t detail;
+   uint64_t gas_used;
+};
+FC_REFLECT(dryrun_result_row, (status)(detail)(gas_used))
+
+struct dryrun_evm_tester : basic_evm_tester
+{
+   enum status : uint8_t { ok = 0, undecodable = 1, fee_rejected = 2, bad_sender = 3, invalid = 4, failed = 5 };
+
+   evm_eoa faucet_eoa;
+
+   dryrun_evm_tester() :
+      faucet_eoa(evmc::from_hex("a3f1b69da92a0233ce29485d3049a4ace39e8d384bbc2557e3fc60940ce4e954").value())
+   {
+      init();
+      transfer_token(faucet_account_name, evm_account_name, make_asset(100'0000), faucet_eoa.address_0x());
+   }
+
+   static bytes encode(const silkworm::Transaction& trx)
+   {
+      silkworm::Bytes rlp;
+      silkworm::rlp::encode(rlp, trx);
+      return bytes{rlp.begin(), rlp.end()};
+   }
+
+   std::vector<dryrun_result_row> dryrun(const std::vector<bytes>& rlptxs, bool execute)
+   {
+      auto trace = push_action(evm_account_name, "dryrun"_n, evm_account_name, mvo()("rlptxs", rlptxs)("execute", execute));
+      const auto& return_value = trace->action_traces[0].return_value;
+      return fc::raw::unpack<std::vector<dryrun_result_row>>(return_value.data(), return_value.size());
+   }
+
+   silkworm::Transaction signed_transfer(const evmc::address& to, const intx::uint256& value)
+   {
+      auto tx = generate_tx(to, value);
+      faucet_eoa.sign(tx);
+      return tx;
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(dryrun_evm_tests)
+
+BOOST_FIXTURE_TEST_CASE(batched_validation, dryrun_evm_tester)
+try {
+   evm_eoa recipient;
+   const auto balance_before = *evm_balance(faucet_eoa);
+
+   // Consecutive nonces of one sender are accepted within a batch
+   auto first = signed_transfer(recipient.address, 1);
+   auto second = signed_transfer(recipient.address, 1);
+
+   auto skipped_nonce = generate_tx(recipient.address, 1);
+   faucet_eoa.next_nonce += 5;
+   faucet_eoa.sign(skipped_nonce);
+
+   auto cheap = generate_tx(recipient.address, 1);
+   cheap.max_fee_per_gas = cheap.max_priority_fee_per_gas = 1;
+   faucet_eoa.sign(cheap);
+
+   auto results = dryrun({encode(first), encode(second), encode(skipped_nonce), encode(cheap), bytes{'x', 'y'}}, false);
+   BOOST_REQUIRE_EQUAL(results.size(), 5);
+   BOOST_CHECK_EQUAL(results[0].status, ok);
+   BOOST_CHECK_EQUAL(results[1].status, ok);
+   BOOST_CHECK_EQUAL(results[2].status, invalid);
+   BOOST_CHECK_EQUAL(results[2].detail, static_cast<uint8_t>(silkworm::ValidationResult::kWrongNonce));
+   BOOST_CHECK_EQUAL(results[3].status, fee_rejected);
+   BOOST_CHECK_EQUAL(results[4].status, undecodable);
+   BOOST_CHECK_EQUAL(results[0].gas_used, 0);
+
+   // Nothing was written, the transactions can still be pushed
+   BOOST_CHECK_EQUAL(*evm_balance(faucet_eoa), balance_before);
+   BOOST_CHECK(!evm_balance(recipient).has_value());
+   pushtx(first);
+   pushtx(second);
+   BOOST_CHECK_EQUAL(*evm_balance(recipient), 2);
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(executed_dryrun, dryrun_evm_tester)
+try {
+   evm_eoa recipient;
+   const auto balance_before = *evm_balance(faucet_eoa);
+
+   // Executed transactions report their gas and are seen by the following ones
+   auto first = signed_transfer(recipient.address, 1000);
+   auto second = signed_transfer(recipient.address, 1000);
+   auto results = dryrun({encode(first), encode(second)}, true);
+   BOOST_REQUIRE_EQUAL(results.size(), 2);
+   BOOST_CHECK_EQUAL(results[0].status, ok);
+   BOOST_CHECK_EQUAL(results[0].gas_used, 21000);
+   BOOST_CHECK_EQUAL(results[1].status, ok);
+   BOOST_CHECK_EQUAL(results[1].gas_used, 21000);
+   BOOST_CHECK_EQUAL(*evm_balance(faucet_eoa), balance_before);
+   BOOST_CHECK(!evm_balance(recipient).has_value());
+
+   // The whole balance leaves nothing for the gas
+   faucet_eoa.next_nonce = 0;
+   auto everything = signed_transfer(recipient.address, balance_before);
+   results = dryrun({encode(everything)}, true);
+   BOOST_REQUIRE_EQUAL(results.size(), 1);
+   BOOST_CHECK_EQUAL(results[0].status, invalid);
+   BOOST_CHECK_EQUAL(results[0].detail, static_cast<uint8_t>(silkworm::ValidationResult::kInsufficientFunds));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -281,14 +281,43 @@ struct account {
       return index_name(name{n});
    }
 
-   static std::optional<account> get_by_address(chainbase::database& db, const evmc::address& address) {
-      auto r = get_by_index<evmc::address, account>(db, "evm"_n, "by.address"_n, address);
-      return r;
-   }
+   static std::optional<account> get_by_address(chainbase::database& db, const evmc::address& address);
 
 };
 FC_REFLECT(account, (id)(eth_address)(nonce)(balance)(code_id));
 
+struct account_v2 {
+   uint64_t       id;
+   fc::ripemd160  eth_address;
+   uint64_t       nonce;
+   fc::sha256     balance;
+   uint64_t       code_id;
+
+   static name table_name() { return "account2"_n; }
+   static name index_name(const name& n) {
+      uint64_t index_table_name = table_name().to_uint64_t() & 0xFFFFFFFFFFFFFFF0ULL;
+
+      return name{index_table_name | 0};
+   }
+
+   account to_account()const {
+      account res{.id = id, .nonce = nonce};
+      res.eth_address = bytes{eth_address.data(), eth_address.data() + eth_address.data_size()};
+      res.balance = bytes{balance.data(), balance.data() + balance.data_size()};
+      if (code_id) res.code_id = code_id - 1;
+      return res;
+   }
+};
+FC_REFLECT(account_v2, (id)(eth_address)(nonce)(balance)(code_id));
+
+// Accounts are found in the compact table first, then among the rows not migrated yet
+std::optional<account> account::get_by_address(chainbase::database& db, const evmc::address& address) {
+   if (auto r = get_by_index<evmc::address, account_v2>(db, "evm"_n, "by.address"_n, address)) {
+      return r->to_account();
+   }
+   return get_by_index<evmc::address, account>(db, "evm"_n, "by.address"_n, address);
+}
+
 struct account_code {
    uint64_t    id;
    uint32_t    ref_count;
@@ -328,6 +357,43 @@ struct account_code {
 };
 FC_REFLECT(account_code, (id)(ref_count)(code)(code_hash));
 
+struct storage_v2 {
+   uint64_t   id;
+   fc::sha256 key;
+   bytes      value;
+
+   evmc::bytes32 get_value() const {
+      evmc::bytes32 res;
+      std::copy(value.begin(), value.end(), res.bytes + sizeof(res.bytes) - value.size());
+      return res;
+   }
+
+   static name table_name() { return "storagev2"_n; }
+
+   static uint64_t id_of(const evmc::bytes32& key) {
+      uint64_t id = 0;
+      for (size_t i = sizeof(key.bytes) - sizeof(id); i < sizeof(key.bytes); ++i) {
+         id = (id << 8) | key.bytes[i];
+      }
+      return id;
+   }
+
+   static std::optional<storage_v2> get(chainbase::database& db, uint64_t account, const evmc::bytes32& key) {
+      const auto* tab = db.find<table_id_object, by_code_scope_table>(
+         boost::make_tuple("evm"_n, name{account}, table_name())
+      );
+      if (tab == nullptr) return {};
+
+      const auto* kv_obj = db.find<key_value_object, by_scope_primary>(boost::make_tuple(tab->id, id_of(key)));
+      if (kv_obj == nullptr) return {};
+
+      auto r = fc::raw::unpack<storage_v2>(kv_obj->value.data(), kv_obj->value.size());
+      if (memcmp(r.key.data(), key.bytes, sizeof(key.bytes)) != 0) return {};
+      return r;
+   }
+};
+FC_REFLECT(storage_v2, (id)(key)(value));
+
 struct storage {
    uint64_t id;
    bytes    key;
@@ -364,6 +430,9 @@ struct storage {
    }
 
    static std::optional<storage> get(chainbase::database& db, uint64_t account, const evmc::bytes32& key) {
+      if (auto slot = storage_v2::get(db, account, key)) {
+         return storage{slot->id, to_bytes(key), to_bytes(slot->get_value())};
+      }
       return get_by_index<evmc::bytes32, storage>(db, name{account}, "by.key"_n, key);
    }
 
@@ -533,6 +602,25 @@ struct evm_runtime_tester : eosio_system_tester, silkworm::State {
       );
    }
 
+   action_result migratestor( uint32_t max, name signer=ME ) {
+      return call(signer, "migratestor"_n, mvo()
+                  ("max", max)
+      );
+   }
+
+   action_result migrateacct( uint32_t max, name signer=ME ) {
+      return call(signer, "migrateacct"_n, mvo()
+                  ("max", max)
+      );
+   }
+
+   action_result setbal( const bytes& address, const bytes& balance, name signer=ME ) {
+      return call(signer, "setbal"_n, mvo()
+                  ("addy", address)
+                  ("bal", balance)
+      );
+   }
+
    action_result dumpstorage(const bytes& address, name signer=ME ) { 
       return call(signer, "dumpstorage"_n, mvo()
          ("addy", address)
@@ -726,18 +814,20 @@ struct evm_runtime_tester : eosio_system_tester, silkworm::State {
    size_t number_of_accounts() {
       auto& db = const_cast<chainbase::database&>(control->db());
 
-      const auto* tid = db.find<table_id_object, by_code_scope_table>(
-         boost::make_tuple("evm"_n, "evm"_n,"account"_n)
-      );
+      size_t count=0;
+      for (auto table : {"account"_n, "account2"_n}) {
+         const auto* tid = db.find<table_id_object, by_code_scope_table>(
+            boost::make_tuple("evm"_n, "evm"_n, table)
+         );
 
-      if(tid == nullptr) return 0;
+         if(tid == nullptr) continue;
 
-      const auto& idx = db.get_index<key_value_index, by_scope_primary>();
-      auto itr = idx.lower_bound( boost::make_tuple( tid->id) );
-      size_t count=0;
-      while ( itr != idx.end() && itr->t_id == tid->id ) {
-         ++itr;
-         ++count;
+         const auto& idx = db.get_index<key_value_index, by_scope_primary>();
+         auto itr = idx.lower_bound( boost::make_tuple( tid->id) );
+         while ( itr != idx.end() && itr->t_id == tid->id ) {
+            ++itr;
+            ++count;
+         }
       }
       return count;
    }
@@ -750,40 +840,22 @@ struct evm_runtime_tester : eosio_system_tester, silkworm::State {
          return 0;
       }
 
-      //dlog("${a}", ("a",*accnt));
-      const auto* tid = db.find<table_id_object, by_code_scope_table>(
-         boost::make_tuple("evm"_n, name{accnt->id}, storage::table_name())
-      );
-
-      if(tid == nullptr) {
-         dlog("${a} => 0 (bis)",("a",to_bytes(address)));
-         return 0;
-      }
-
-      fc::mutable_variant_object mr;
-      mr("a",to_bytes(address));
-      //std::cout << "state_storage_size: " << fc::format_string("${a}",mr,true) << std::endl;
-
-      const auto& idx = db.get_index<key_value_index, by_scope_primary>();
-      auto itr = idx.lower_bound( boost::make_tuple(tid->id) );
+      // Slots live in the v2 table, or in the legacy one when their v2 primary key is taken
       size_t count=0;
-      while ( itr != idx.end() && itr->t_id == tid->id ) {
-
-         auto r = fc::raw::unpack<storage>(
-            itr->value.data(),
-            itr->value.size()
+      for (auto table : {storage_v2::table_name(), storage::table_name()}) {
+         const auto* tid = db.find<table_id_object, by_code_scope_table>(
+            boost::make_tuple("evm"_n, name{accnt->id}, table)
          );
+         if(tid == nullptr) continue;
 
-         // fc::mutable_variant_object mu;
-         // mu( "a", r.key );
-         // mu( "b", r.value );
-         // std::cout << fc::format_string("   ${a}=${b}", mu, true) << std::endl;
-         
-         ++itr;
-         ++count;
+         const auto& idx = db.get_index<key_value_index, by_scope_primary>();
+         auto itr = idx.lower_bound( boost::make_tuple(tid->id) );
+         while ( itr != idx.end() && itr->t_id == tid->id ) {
+            ++itr;
+            ++count;
+         }
       }
       //dlog("${a} => ${c}",("a",to_bytes(address))("c",count));
-      //std::cout << "   total: " << count << std::endl;
       return count;
    }
 
@@ -1160,4 +1232,90 @@ BOOST_FIXTURE_TEST_CASE( balance_and_dust_tests, evm_runtime_tester ) try {
    BOOST_REQUIRE_EQUAL(testbaldust("overflowd"_n),  error("assertion failure with message: accumulation overflow"));
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( storage_v2_collision_tests, evm_runtime_tester ) try {
+   evmc::address address;
+   std::fill(std::begin(address.bytes), std::end(address.bytes), 0x42);
+
+   // Both slots share their low 64 bits, hence their v2 primary key
+   evmc::bytes32 slot_a, slot_b, value_a, value_b;
+   slot_a.bytes[31] = 7;
+   slot_b.bytes[0] = 1;
+   slot_b.bytes[31] = 7;
+   value_a.bytes[31] = 0x11;
+   value_b.bytes[30] = 0x22;
+
+   BOOST_REQUIRE_EQUAL(updatestore(to_bytes(address), 0, to_bytes(slot_a), to_bytes(evmc::bytes32{}), to_bytes(value_a)), success());
+   BOOST_REQUIRE_EQUAL(updatestore(to_bytes(address), 0, to_bytes(slot_b), to_bytes(evmc::bytes32{}), to_bytes(value_b)), success());
+
+   auto& db = const_cast<chainbase::database&>(control->db());
+   auto accnt = account::get_by_address(db, address);
+   BOOST_REQUIRE(accnt);
+   BOOST_REQUIRE(storage_v2::get(db, accnt->id, slot_a));
+   BOOST_REQUIRE(!storage_v2::get(db, accnt->id, slot_b));
+   BOOST_REQUIRE(read_storage(address, 0, slot_a) == value_a);
+   BOOST_REQUIRE(read_storage(address, 0, slot_b) == value_b);
+   BOOST_REQUIRE_EQUAL(state_storage_size(address, 0), 2);
+
+   // Once the first slot is gone the migration moves the other one to the v2 table
+   BOOST_REQUIRE_EQUAL(updatestore(to_bytes(address), 0, to_bytes(slot_a), to_bytes(value_a), to_bytes(evmc::bytes32{})), success());
+   BOOST_REQUIRE(read_storage(address, 0, slot_a) == evmc::bytes32{});
+   create_accounts({"alice"_n});
+   BOOST_REQUIRE_EQUAL(migratestor(100, "alice"_n), error("missing authority of evm"));
+   BOOST_REQUIRE_EQUAL(migratestor(100), success());
+   BOOST_REQUIRE(storage_v2::get(db, accnt->id, slot_b));
+   BOOST_REQUIRE(read_storage(address, 0, slot_b) == value_b);
+   BOOST_REQUIRE_EQUAL(state_storage_size(address, 0), 1);
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( account_migration_tests, evm_runtime_tester ) try {
+   auto& db = const_cast<chainbase::database&>(control->db());
+
+   // setbal writes new accounts in the legacy layout
+   std::vector<evmc::address> addresses(3);
+   for (size_t i = 0; i < addresses.size(); ++i) {
+      std::fill(std::begin(addresses[i].bytes), std::end(addresses[i].bytes), 0x10 + i);
+      evmc::bytes32 balance;
+      balance.bytes[31] = i + 1;
+      BOOST_REQUIRE_EQUAL(setbal(to_bytes(addresses[i]), to_bytes(balance)), success());
+   }
+   auto is_compact = [&](const evmc::address& address) {
+      return get_by_index<evmc::address, account_v2>(db, "evm"_n, "by.address"_n, address).has_value();
+   };
+   BOOST_REQUIRE_EQUAL(number_of_accounts(), 3);
+   BOOST_REQUIRE(!is_compact(addresses[0]));
+   const auto first_id = account::get_by_address(db, addresses[0])->id;
+
+   // Writing an account converts it, keeping its id as that is the scope of its storage
+   auto updated = read_account(addresses[0]);
+   BOOST_REQUIRE(updated);
+   BOOST_REQUIRE(updated->balance == 1);
+   auto current = *updated;
+   current.nonce = 5;
+   update_account(addresses[0], updated, current);
+   BOOST_REQUIRE(is_compact(addresses[0]));
+   BOOST_REQUIRE_EQUAL(account::get_by_address(db, addresses[0])->id, first_id);
+   BOOST_REQUIRE_EQUAL(read_account(addresses[0])->nonce, 5);
+   BOOST_REQUIRE_EQUAL(number_of_accounts(), 3);
+
+   // The migration resumes where it stopped
+   create_accounts({"alice"_n});
+   BOOST_REQUIRE_EQUAL(migrateacct(1, "alice"_n), error("missing authority of evm"));
+   BOOST_REQUIRE_EQUAL(migrateacct(1), success());
+   BOOST_REQUIRE(is_compact(addresses[1]));
+   BOOST_REQUIRE(!is_compact(addresses[2]));
+   BOOST_REQUIRE_EQUAL(migrateacct(100), success());
+   BOOST_REQUIRE(is_compact(addresses[2]));
+   BOOST_REQUIRE_EQUAL(number_of_accounts(), 3);
+   for (size_t i = 0; i < addresses.size(); ++i) {
+      BOOST_REQUIRE(read_account(addresses[i])->balance == i + 1);
+   }
+
+   // New accounts never reuse a legacy id
+   evmc::address fresh;
+   std::fill(std::begin(fresh.bytes), std::end(fresh.bytes), 0x77);
+   update_account(fresh, std::nullopt, Account{0, 9});
+   BOOST_REQUIRE(is_compact(fresh));
+   BOOST_REQUIRE_EQUAL(account::get_by_address(db, fresh)->id, 3);
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -284,4 +284,77 @@ try {
 }
 FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(batched_miner_cut_calculation, gas_fee_evm_tester)
+try {
+   static constexpr uint32_t hundred_percent = 100'000;
+   static constexpr uint64_t gas_price = 1'000'000'000;
+   static constexpr uint32_t miner_cut = 10'000;
+
+   init(evm_chain_id, gas_price, miner_cut);
+   fund_evm_faucet();
+   open(miner_account_name);
+
+   evm_eoa recipient;
+   const auto gas_fee = intx::uint256{gas_price * 21000};
+   const auto gas_fee_miner_portion = (gas_fee * miner_cut) / hundred_percent;
+
+   const intx::uint256 special_balance_before{vault_balance(evm_account_name)};
+   const intx::uint256 miner_balance_before{vault_balance(miner_account_name)};
+   const intx::uint256 faucet_before = evm_balance(faucet_eoa).value();
+
+   // Every transaction of the batch is charged and pays the miner as if it had been pushed on its own
+   std::vector<silkworm::Transaction> txs;
+   for (uint64_t i = 1; i <= 3; ++i) {
+      auto tx = generate_tx(recipient.address, 1_gwei * i);
+      faucet_eoa.sign(tx);
+      txs.push_back(tx);
+   }
+   pushtxs(txs, miner_account_name);
+
+   BOOST_CHECK_EQUAL(*evm_balance(faucet_eoa), (faucet_before - 6_gwei - gas_fee * 3));
+   BOOST_REQUIRE(evm_balance(recipient).has_value());
+   BOOST_CHECK_EQUAL(*evm_balance(recipient), 6_gwei);
+   BOOST_CHECK_EQUAL(static_cast<intx::uint256>(vault_balance(evm_account_name)),
+                     (special_balance_before + (gas_fee - gas_fee_miner_portion) * 3));
+   BOOST_CHECK_EQUAL(static_cast<intx::uint256>(vault_balance(miner_account_name)),
+                     (miner_balance_before + gas_fee_miner_portion * 3));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(batched_reserved_balance_starts_empty, gas_fee_evm_tester)
+try {
+   init(evm_chain_id, 1'000'000'000, 10'000);
+   fund_evm_faucet();
+   open(miner_account_name);
+
+   // Runtime code storing BALANCE(reserved address of the contract) + 1 in slot 0
+   const evmc::address reserved = make_reserved_address(evm_account_name.to_uint64_t());
+   evmc::bytes code = evmc::from_hex("601d600c600039601d6000f3" "73").value();
+   code.append(reserved.bytes, sizeof(reserved.bytes));
+   code += evmc::from_hex("3160010160005500").value();
+   auto contract_address = deploy_contract(faucet_eoa, code);
+   auto contract_account = find_account_by_address(contract_address);
+   BOOST_REQUIRE(contract_account.has_value());
+
+   // The gas of the first transaction goes through the reserved address, the second one must still see it empty
+   evm_eoa recipient;
+   std::vector<silkworm::Transaction> txs;
+   auto transfer = generate_tx(recipient.address, 1_gwei);
+   faucet_eoa.sign(transfer);
+   txs.push_back(transfer);
+   auto call = generate_tx(contract_address, 0, 100'000);
+   faucet_eoa.sign(call);
+   txs.push_back(call);
+   pushtxs(txs, miner_account_name);
+
+   std::optional<intx::uint256> stored;
+   scan_account_storage(contract_account->id, [&](storage_slot&& slot) -> bool {
+      if (slot.key == 0) stored = slot.value;
+      return false;
+   });
+   BOOST_REQUIRE(stored.has_value());
+   BOOST_CHECK_EQUAL(*stored, 1);
+}
+FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "basic_evm_tester.hpp"
+
+using namespace eosio::testing;
+using namespace evm_test;
+
+struct gc_state_row
+{
+   uint32_t rows_per_tx;
+   uint64_t collected;
+   uint64_t rows_erased;
+};
+FC_REFLECT(gc_state_row, (rows_per_tx)(collected)(rows_erased))
+
+struct gc_store_row
+{
+   uint64_t id;
+   uint64_t storage_id;
+};
+FC_REFLECT(gc_store_row, (id)(storage_id))
+
+struct gc_evm_tester : basic_evm_tester
+{
+   // Constructor storing 1 at slot 0 and 2 at slot 1, runtime code self destructing to the caller
+   static constexpr const char* self_destruct_bytecode_hex = "600160005560026001556002601660003960026000f333ff";
+
+   evm_eoa faucet_eoa;
+
+   gc_evm_tester() :
+      faucet_eoa(evmc::from_hex("a3f1b69da92a0233ce29485d3049a4ace39e8d384bbc2557e3fc60940ce4e954").value())
+   {
+      init();
+      transfer_token(faucet_account_name, evm_account_name, make_asset(100'0000), faucet_eoa.address_0x());
+   }
+
+   void setgcparams(uint32_t rows_per_tx)
+   {
+      push_action(evm_account_name, "setgcparams"_n, evm_account_name, mvo()("rows_per_tx", rows_per_tx));
+   }
+
+   gc_state_row gc_state() const
+   {
+      gc_state_row result{};
+      scan_table<gc_state_row>("gcstate"_n, evm_account_name, [&](gc_state_row&& row) {
+         result = row;
+         return true;
+      });
+      return result;
+   }
+
+   bool has_gc_state() const
+   {
+      bool found = false;
+      scan_table<gc_state_row>("gcstate"_n, evm_account_name, [&](gc_state_row&&) {
+         found = true;
+         return true;
+      });
+      return found;
+   }
+
+   size_t gc_store_size() const
+   {
+      size_t count = 0;
+      scan_table<gc_store_row>("gcstore"_n, evm_account_name, [&](gc_store_row&&) {
+         ++count;
+         return false;
+      });
+      return count;
+   }
+
+   size_t storage_size(uint64_t account_id) const
+   {
+      size_t count = 0;
+      scan_account_storage(account_id, [&](storage_slot&&) -> bool {
+         ++count;
+         return false;
+      });
+      return count;
+   }
+
+   // Deploys a self destructing contract and calls it, returns the id of its queued storage
+   uint64_t self_destruct_contract()
+   {
+      auto contract_address = deploy_contract(faucet_eoa, evmc::from_hex(self_destruct_bytecode_hex).value());
+      auto contract_account = find_account_by_address(contract_address);
+      BOOST_REQUIRE(contract_account.has_value());
+      BOOST_REQUIRE_EQUAL(storage_size(contract_account->id), 2);
+
+      auto tx = generate_tx(contract_address, 0, 100'000);
+      faucet_eoa.sign(tx);
+      pushtx(tx);
+      BOOST_REQUIRE(!find_account_by_address(contract_address).has_value());
+      return contract_account->id;
+   }
+
+   void transfer_from_faucet()
+   {
+      evm_eoa recipient;
+      auto tx = generate_tx(recipient.address, 1);
+      faucet_eoa.sign(tx);
+      pushtx(tx);
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(gc_evm_tests)
+
+BOOST_FIXTURE_TEST_CASE(budgeted_gc_in_pushtx, gc_evm_tester)
+try {
+   setgcparams(1);
+
+   auto contract_address = deploy_contract(faucet_eoa, evmc::from_hex(self_destruct_bytecode_hex).value());
+   auto contract_account = find_account_by_address(contract_address);
+   BOOST_REQUIRE(contract_account.has_value());
+   BOOST_REQUIRE_EQUAL(storage_size(contract_account->id), 2);
+
+   // The self destruct queues the storage of the contract, the same transaction already erases one row of it
+   auto tx = generate_tx(contract_address, 0, 100'000);
+   faucet_eoa.sign(tx);
+   pushtx(tx);
+   BOOST_REQUIRE(!find_account_by_address(contract_address).has_value());
+   BOOST_CHECK_EQUAL(storage_size(contract_account->id), 1);
+   BOOST_CHECK_EQUAL(gc_store_size(), 1);
+
+   auto gcs = gc_state();
+   BOOST_CHECK_EQUAL(gcs.rows_per_tx, 1);
+   BOOST_CHECK_EQUAL(gcs.collected, 0);
+   BOOST_CHECK_EQUAL(gcs.rows_erased, 1);
+
+   // Any transaction continues the collection, one row at a time
+   transfer_from_faucet();
+   BOOST_CHECK_EQUAL(storage_size(contract_account->id), 0);
+   BOOST_CHECK_EQUAL(gc_store_size(), 1);
+
+   transfer_from_faucet();
+   BOOST_CHECK_EQUAL(gc_store_size(), 0);
+
+   gcs = gc_state();
+   BOOST_CHECK_EQUAL(gcs.collected, 1);
+   BOOST_CHECK_EQUAL(gcs.rows_erased, 2);
+
+   // Nothing left, the counters do not move
+   transfer_from_faucet();
+   BOOST_CHECK_EQUAL(gc_state().rows_erased, 2);
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(budgeted_gc_after_drained_queue, gc_evm_tester)
+try {
+   setgcparams(10);
+
+   auto first_id = self_destruct_contract();
+   BOOST_CHECK_EQUAL(storage_size(first_id), 0);
+   BOOST_CHECK_EQUAL(gc_store_size(), 0);
+
+   // gcstore is empty again, storage removed afterwards must still be collected
+   auto second_id = self_destruct_contract();
+   BOOST_CHECK_EQUAL(storage_size(second_id), 0);
+   BOOST_CHECK_EQUAL(gc_store_size(), 0);
+
+   auto gcs = gc_state();
+   BOOST_CHECK_EQUAL(gcs.collected, 2);
+   BOOST_CHECK_EQUAL(gcs.rows_erased, 4);
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(gc_left_to_action_by_default, gc_evm_tester)
+try {
+   auto contract_address = deploy_contract(faucet_eoa, evmc::from_hex(self_destruct_bytecode_hex).value());
+   auto contract_account = find_account_by_address(contract_address);
+   BOOST_REQUIRE(contract_account.has_value());
+
+   auto tx = generate_tx(contract_address, 0, 100'000);
+   faucet_eoa.sign(tx);
+   pushtx(tx);
+   transfer_from_faucet();
+   BOOST_CHECK_EQUAL(storage_size(contract_account->id), 2);
+   BOOST_CHECK_EQUAL(gc_store_size(), 1);
+   // Queuing storage for collection leaves the gc settings and counters alone
+   BOOST_CHECK(!has_gc_state());
+
+   push_action(evm_account_name, "gc"_n, evm_account_name, mvo()("max", 100));
+   BOOST_CHECK_EQUAL(storage_size(contract_account->id), 0);
+   BOOST_CHECK_EQUAL(gc_store_size(), 0);
+   BOOST_CHECK_EQUAL(gc_state().collected, 1);
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,65 @@
+#!/usr/bin/python3
+""" Compare an EVM contract profile produced by evm_profile_tests against the tracked baseline """
+
+import argparse
+import json
+import sys
+
+
+def load(path: str):
+    "Read the JSON lines written by evm_profile_tests, the last line of a scenario wins."
+    scenarios = {}
+    with open(path, encoding="utf8") as profile:
+        for line in profile:
+            line = line.strip()
+            if line:
+                entry = json.loads(line)
+                scenarios[entry["scenario"]] = entry
+    return scenarios
+
+
+def compare(baseline: dict, current: dict, cpu_tolerance: float):
+    "Return the regressions of `current` against `baseline`, RAM and db_stats are deterministic and compared exactly."
+    regressions = []
+    for name, entry in sorted(current.items()):
+        base = baseline.get(name)
+        if base is None:
+            print(f"{name}: no baseline")
+            continue
+
+        cpu, base_cpu = entry["cpu_us"]["median"], base["cpu_us"]["median"]
+        ram, base_ram = entry["ram_delta_bytes"], base["ram_delta_bytes"]
+        print(f"{name}: cpu median {base_cpu} -> {cpu} us, ram {base_ram} -> {ram} bytes")
+
+        if cpu > base_cpu * (1 + cpu_tolerance):
+            regressions.append(f"{name}: cpu median {base_cpu} -> {cpu} us")
+        if ram > base_ram:
+            regressions.append(f"{name}: ram {base_ram} -> {ram} bytes")
+
+        stats, base_stats = entry.get("db_stats"), base.get("db_stats")
+        if stats is not None and base_stats is not None:
+            for table, counters in stats.items():
+                for counter, value in counters.items():
+                    base_value = base_stats.get(table, {}).get(counter, value)
+                    if value > base_value:
+                        regressions.append(f"{name}: {table} {counter} {base_value} -> {value}")
+    return regressions
+
+
+def main():
+    "Entry point."
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("current", help="profile written through EVM_PROFILE_OUTPUT")
+    parser.add_argument("--baseline", default="baseline.jsonl", help="tracked baseline profile")
+    parser.add_argument("--cpu-tolerance", type=float, default=0.15,
+                        help="allowed relative increase of the median billed CPU")
+    args = parser.parse_args()
+
+    regressions = compare(load(args.baseline), load(args.current), args.cpu_tolerance)
+    for regression in regressions:
+        print(f"REGRESSION {regression}")
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
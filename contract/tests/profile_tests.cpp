@@ -0,0 +1,348 @@
+#include "basic_evm_tester.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+#include <eosio/chain/resource_limits.hpp>
+
+#include <silkworm/common/cast.hpp>
+
+using namespace eosio::testing;
+using namespace evm_test;
+
+// CPU profiling harness of the EVM contract.
+//
+// Every scenario deploys a workload, pushes it through pushtx and reports, as one JSON object per line, the billed CPU
+// and the RAM used by the EVM account per transaction together with the db_stats counters of the contract. The counters
+// are only printed by contracts built with -DWITH_DB_STATS=1 and are reported as null otherwise.
+//
+// The suite is disabled by default, run it with
+//    unit_test --run_test=evm_profile_tests
+// The output is appended to the file named by EVM_PROFILE_OUTPUT, if set, and compared against the tracked baseline
+// with contract/tests/profile/compare_profile.py.
+
+namespace {
+
+enum opcode : uint8_t {
+   STOP = 0x00, ADD = 0x01, MUL = 0x02, SUB = 0x03, DIV = 0x04, LT = 0x10, ISZERO = 0x15, KECCAK256 = 0x20,
+   CALLER = 0x33, CALLDATALOAD = 0x35, CODECOPY = 0x39, POP = 0x50, MSTORE = 0x52, SLOAD = 0x54, SSTORE = 0x55,
+   JUMP = 0x56, JUMPI = 0x57, JUMPDEST = 0x5b, PUSH1 = 0x60, PUSH2 = 0x61, PUSH32 = 0x7f, DUP1 = 0x80, DUP2 = 0x81,
+   DUP3 = 0x82, DUP4 = 0x83, DUP5 = 0x84, SWAP1 = 0x90, SWAP2 = 0x91, LOG2 = 0xa2, LOG3 = 0xa3, LOG4 = 0xa4,
+   RETURN = 0xf3, REVERT = 0xfd,
+};
+
+// Minimal assembler for the workloads below, there is no Solidity toolchain in the test build
+class evm_asm
+{
+public:
+   evm_asm& op(std::initializer_list<uint8_t> ops)
+   {
+      code.insert(code.end(), ops.begin(), ops.end());
+      return *this;
+   }
+
+   evm_asm& push(const intx::uint256& value)
+   {
+      uint8_t be[32];
+      intx::be::store(be, value);
+      size_t skip = 0;
+      while (skip < 31 && be[skip] == 0) ++skip;
+      code.push_back(PUSH1 + (31 - skip));
+      code.insert(code.end(), be + skip, be + 32);
+      return *this;
+   }
+
+   evm_asm& push(const evmc::bytes32& value)
+   {
+      code.push_back(PUSH32);
+      code.insert(code.end(), value.bytes, value.bytes + 32);
+      return *this;
+   }
+
+   evm_asm& push_label(const std::string& name)
+   {
+      code.push_back(PUSH2);
+      fixups.emplace_back(code.size(), name);
+      code.insert(code.end(), {0, 0});
+      return *this;
+   }
+
+   evm_asm& label(const std::string& name)
+   {
+      labels[name] = code.size();
+      code.push_back(JUMPDEST);
+      return *this;
+   }
+
+   // Slot of `mapping[key]` for the mapping at `slot`, with the key on the stack: keccak256(key . slot)
+   evm_asm& mapping_slot(uint64_t slot)
+   {
+      return push(0).op({MSTORE}).push(slot).push(32).op({MSTORE}).push(64).push(0).op({KECCAK256});
+   }
+
+   silkworm::Bytes build() const
+   {
+      auto result = code;
+      for (const auto& [pos, name] : fixups) {
+         auto target = labels.at(name);
+         result[pos] = uint8_t(target >> 8);
+         result[pos + 1] = uint8_t(target);
+      }
+      return result;
+   }
+
+   // Init code running `constructor` and then returning `runtime`
+   static silkworm::Bytes deployer(const silkworm::Bytes& constructor, const silkworm::Bytes& runtime)
+   {
+      static constexpr size_t stub_size = 15;
+      const auto offset = constructor.size() + stub_size;
+      silkworm::Bytes code = constructor;
+      code.insert(code.end(), {PUSH2, uint8_t(runtime.size() >> 8), uint8_t(runtime.size()),
+                               PUSH2, uint8_t(offset >> 8), uint8_t(offset), PUSH1, 0, CODECOPY,
+                               PUSH2, uint8_t(runtime.size() >> 8), uint8_t(runtime.size()), PUSH1, 0, RETURN});
+      code += runtime;
+      return code;
+   }
+
+private:
+   silkworm::Bytes code;
+   std::map<std::string, size_t> labels;
+   std::vector<std::pair<size_t, std::string>> fixups;
+};
+
+evmc::bytes32 event_signature(std::string_view signature)
+{
+   return silkworm::bit_cast<evmc_bytes32>(
+      silkworm::keccak256(silkworm::ByteView{reinterpret_cast<const uint8_t*>(signature.data()), signature.size()}));
+}
+
+silkworm::Bytes word(const intx::uint256& value)
+{
+   silkworm::Bytes w(32, 0);
+   intx::be::unsafe::store(w.data(), value);
+   return w;
+}
+
+silkworm::Bytes word(const evmc::address& address)
+{
+   silkworm::Bytes w(32, 0);
+   std::memcpy(w.data() + 12, address.bytes, sizeof(address.bytes));
+   return w;
+}
+
+const intx::uint256 initial_supply = intx::exp(10_u256, 24_u256);
+
+// ERC-20 style transfer(to, amount): balances mapping at slot 0, Transfer event
+silkworm::Bytes token_transfer_code()
+{
+   evm_asm runtime;
+   runtime.op({CALLER}).mapping_slot(0)                                   // [from_slot]
+      .op({DUP1, SLOAD}).push(32).op({CALLDATALOAD})                      // [from_slot, balance, amount]
+      .op({DUP1, DUP3, LT}).push_label("revert").op({JUMPI})
+      .op({SWAP1, DUP2, SWAP1, SUB, DUP3, SSTORE})                        // [from_slot, amount]
+      .push(0).op({CALLDATALOAD}).mapping_slot(0)                         // [from_slot, amount, to_slot]
+      .op({DUP1, SLOAD, DUP3, ADD, SWAP1, SSTORE})                        // [from_slot, amount]
+      .push(0).op({MSTORE})
+      .push(0).op({CALLDATALOAD, CALLER}).push(event_signature("Transfer(address,address,uint256)"))
+      .push(32).push(0).op({LOG3, STOP})
+      .label("revert").push(0).op({DUP1, REVERT});
+
+   evm_asm constructor;
+   constructor.push(initial_supply).op({CALLER}).mapping_slot(0).op({SSTORE});
+   return evm_asm::deployer(constructor.build(), runtime.build());
+}
+
+// Constant product swap(amount_in): reserves at slots 0 and 1, output credited to the balances mapping at slot 2
+silkworm::Bytes swap_code()
+{
+   evm_asm runtime;
+   runtime.push(0).op({CALLDATALOAD}).push(0).op({SLOAD}).push(1).op({SLOAD})  // [in, r0, r1]
+      .op({DUP3, DUP2, MUL, DUP4, DUP4, ADD, SWAP1, DIV})                      // [in, r0, r1, out]
+      .op({SWAP1, DUP2, SWAP1, SUB}).push(1).op({SSTORE})                      // [in, r0, out]
+      .op({SWAP2, ADD}).push(0).op({SSTORE})                                   // [out]
+      .op({CALLER}).mapping_slot(2).op({DUP1, SLOAD, DUP3, ADD, SWAP1, SSTORE})
+      .push(0).op({MSTORE, CALLER}).push(event_signature("Swap(address,uint256)"))
+      .push(32).push(0).op({LOG2, STOP});
+
+   evm_asm constructor;
+   constructor.push(initial_supply).push(0).op({SSTORE}).push(initial_supply).push(1).op({SSTORE});
+   return evm_asm::deployer(constructor.build(), runtime.build());
+}
+
+// NFT mint(): token counter at slot 0, owners mapping at slot 1, balances mapping at slot 2, Transfer event
+silkworm::Bytes nft_mint_code()
+{
+   evm_asm runtime;
+   runtime.push(0).op({SLOAD}).push(1).op({ADD, DUP1}).push(0).op({SSTORE})  // [id]
+      .op({DUP1}).mapping_slot(1).op({CALLER, SWAP1, SSTORE})
+      .op({CALLER}).mapping_slot(2).op({DUP1, SLOAD}).push(1).op({ADD, SWAP1, SSTORE})
+      .op({CALLER}).push(0).push(event_signature("Transfer(address,address,uint256)"))
+      .push(0).push(0).op({LOG4, STOP});
+   return evm_asm::deployer({}, runtime.build());
+}
+
+// fill(n): writes n new storage slots after the ones written by the previous calls, counted at slot 0
+silkworm::Bytes storage_loop_code()
+{
+   evm_asm runtime;
+   runtime.push(0).op({SLOAD}).push(0).op({CALLDATALOAD}).push(0)           // [c, n, i]
+      .label("loop")
+      .op({DUP2, DUP2, LT, ISZERO}).push_label("end").op({JUMPI})
+      .op({DUP1}).push(1).op({ADD, DUP1, DUP5, ADD, SSTORE})
+      .push(1).op({ADD}).push_label("loop").op({JUMP})
+      .label("end")
+      .op({POP, ADD}).push(0).op({SSTORE, STOP});
+   return evm_asm::deployer({}, runtime.build());
+}
+
+struct scenario_result
+{
+   std::vector<uint32_t> cpu_us;
+   std::vector<int64_t> ram_delta;
+   std::optional<std::string> db_stats;
+};
+
+} // namespace
+
+struct profile_evm_tester : basic_evm_tester
+{
+   static constexpr uint32_t iterations = 20;
+   static constexpr uint32_t fill_slots = 20;
+
+   evm_eoa faucet_eoa;
+
+   profile_evm_tester() :
+      faucet_eoa(evmc::from_hex("a3f1b69da92a0233ce29485d3049a4ace39e8d384bbc2557e3fc60940ce4e954").value())
+   {
+      init();
+      transfer_token(faucet_account_name, evm_account_name, make_asset(100'0000), faucet_eoa.address_0x());
+      produce_block();
+   }
+
+   int64_t evm_ram_usage() const
+   {
+      return control->get_resource_limits_manager().get_account_ram_usage(evm_account_name);
+   }
+
+   // "db_stats account r u c d storage r u c d" printed by contracts built with WITH_DB_STATS, as JSON
+   static std::optional<std::string> parse_db_stats(const transaction_trace_ptr& trace)
+   {
+      for (const auto& at : trace->action_traces) {
+         auto pos = at.console.find("db_stats account ");
+         if (pos == std::string::npos) continue;
+         std::istringstream in(at.console.substr(pos));
+         std::string tag, table;
+         uint32_t c[8];
+         in >> tag >> table >> c[0] >> c[1] >> c[2] >> c[3] >> table >> c[4] >> c[5] >> c[6] >> c[7];
+         if (!in) return {};
+         std::ostringstream out;
+         out << R"({"account":{"read":)" << c[0] << R"(,"update":)" << c[1] << R"(,"create":)" << c[2]
+             << R"(,"remove":)" << c[3] << R"(},"storage":{"read":)" << c[4] << R"(,"update":)" << c[5]
+             << R"(,"create":)" << c[6] << R"(,"remove":)" << c[7] << "}}";
+         return out.str();
+      }
+      return {};
+   }
+
+   // Pushes `iterations` transactions made by `make_tx`, each in its own block
+   template <typename MakeTx>
+   scenario_result run(MakeTx&& make_tx)
+   {
+      scenario_result result;
+      for (uint32_t i = 0; i < iterations; ++i) {
+         auto tx = make_tx(i);
+         faucet_eoa.sign(tx);
+         const auto ram_before = evm_ram_usage();
+         auto trace = pushtx(tx);
+         result.ram_delta.push_back(evm_ram_usage() - ram_before);
+         result.cpu_us.push_back(trace->receipt->cpu_usage_us);
+         result.db_stats = parse_db_stats(trace);
+         produce_block();
+      }
+      return result;
+   }
+
+   silkworm::Transaction call(const evmc::address& to, silkworm::Bytes data, uint64_t gas_limit = 1'000'000)
+   {
+      auto tx = generate_tx(to, 0, gas_limit);
+      tx.data = std::move(data);
+      return tx;
+   }
+
+   void report(const std::string& scenario, scenario_result result)
+   {
+      std::sort(result.cpu_us.begin(), result.cpu_us.end());
+      const auto cpu_total = std::accumulate(result.cpu_us.begin(), result.cpu_us.end(), uint64_t{0});
+      const auto ram_total = std::accumulate(result.ram_delta.begin(), result.ram_delta.end(), int64_t{0});
+
+      std::ostringstream line;
+      line << R"({"scenario":")" << scenario << R"(","iterations":)" << result.cpu_us.size()
+           << R"(,"cpu_us":{"min":)" << result.cpu_us.front()
+           << R"(,"median":)" << result.cpu_us[result.cpu_us.size() / 2]
+           << R"(,"mean":)" << cpu_total / result.cpu_us.size()
+           << R"(,"max":)" << result.cpu_us.back()
+           << R"(},"ram_delta_bytes":)" << ram_total / int64_t(result.ram_delta.size())
+           << R"(,"db_stats":)" << result.db_stats.value_or("null") << "}";
+
+      BOOST_TEST_MESSAGE(line.str());
+      if (const char* path = std::getenv("EVM_PROFILE_OUTPUT")) {
+         std::ofstream out(path, std::ios::app);
+         out << line.str() << "\n";
+      }
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(evm_profile_tests, *boost::unit_test::disabled())
+
+BOOST_FIXTURE_TEST_CASE(native_transfer, profile_evm_tester)
+try {
+   evm_eoa recipient;
+   report("native_transfer", run([&](uint32_t) { return generate_tx(recipient.address, 1); }));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(erc20_transfer, profile_evm_tester)
+try {
+   auto token = deploy_contract(faucet_eoa, token_transfer_code());
+   produce_block();
+
+   // Every transaction credits a new holder
+   report("erc20_transfer", run([&](uint32_t i) {
+      evm_eoa recipient;
+      return call(token, word(recipient.address) + word(i + 1));
+   }));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(swap, profile_evm_tester)
+try {
+   auto pool = deploy_contract(faucet_eoa, swap_code());
+   produce_block();
+
+   report("swap", run([&](uint32_t i) { return call(pool, word(intx::exp(10_u256, 18_u256) * (i + 1))); }));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(nft_mint, profile_evm_tester)
+try {
+   auto nft = deploy_contract(faucet_eoa, nft_mint_code());
+   produce_block();
+
+   report("nft_mint", run([&](uint32_t) { return call(nft, {}); }));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(storage_loop, profile_evm_tester)
+try {
+   auto filler = deploy_contract(faucet_eoa, storage_loop_code());
+   produce_block();
+
+   report("storage_loop", run([&](uint32_t) { return call(filler, word(fill_slots), 5'000'000); }));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
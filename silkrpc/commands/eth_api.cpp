@@ -17,13 +17,23 @@
 #include "eth_api.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <deque>
 #include <exception>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/experimental/as_tuple.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/endian/conversion.hpp>
 #include <evmc/evmc.hpp>
 #include <silkworm/chain/config.hpp>
@@ -37,6 +47,7 @@
 #include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/common/util.hpp>
+#include <silkrpc/common/writer.hpp>
 #include <silkrpc/core/cached_chain.hpp>
 #include <silkrpc/core/blocks.hpp>
 #include <silkrpc/core/evm_executor.hpp>
@@ -1365,24 +1376,34 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_uninstall_filter(const n
 
 // https://eth.wiki/json-rpc/API#eth_getlogs
 boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann::json& request, nlohmann::json& reply) {
+    // Responses in a batch are needed whole, so the streamed one is collected in memory
+    StringWriter writer;
+    json::Stream stream{writer};
+    co_await handle_eth_get_logs(request, stream);
+    co_await stream.close();
+    reply = nlohmann::json::parse(writer.content());
+}
+
+boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann::json& request, json::Stream& stream) {
     auto params = request["params"];
     if (params.size() != 1) {
         auto error_msg = "invalid eth_getLogs params: " + params.dump();
         SILKRPC_ERROR << error_msg << "\n";
-        reply = make_json_error(request["id"], 100, error_msg);
+        stream.write_json(make_json_error(request["id"], 100, error_msg));
         co_return;
     }
 
     if (params[0].contains("topics") && !params[0]["topics"].is_array()) {
         auto error_msg = "invalid eth_getLogs params. topics should be an array.";
         SILKRPC_ERROR << error_msg << "\n";
-        reply = make_json_error(request["id"], 100, error_msg);
+        stream.write_json(make_json_error(request["id"], 100, error_msg));
         co_return;
     }
 
     auto filter = params[0].get<Filter>();
     SILKRPC_DEBUG << "filter: " << filter << "\n";
-    std::vector<Log> logs;
+    roaring::Roaring64Map block_numbers;
+    std::optional<nlohmann::json> error_reply;
 
     auto tx = co_await database_->begin();
 
@@ -1390,57 +1411,185 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann:
         ethdb::TransactionDatabase tx_database{*tx};
 
         uint64_t start{}, end{};
+        std::optional<evmc::bytes32> block_hash;
         if (filter.block_hash.has_value()) {
             auto block_hash_bytes = silkworm::from_hex(filter.block_hash.value());
-            if (!block_hash_bytes.has_value()) {
+            if (block_hash_bytes.has_value()) {
+                block_hash = silkworm::to_bytes32(block_hash_bytes.value());
+            } else {
                 auto error_msg = "invalid eth_getLogs filter block_hash: " + filter.block_hash.value();
                 SILKRPC_ERROR << error_msg << "\n";
-                reply = make_json_error(request["id"], 100, error_msg);
-                co_await tx->close(); // RAII not (yet) available with coroutines
-                co_return;
+                error_reply = make_json_error(request["id"], 100, error_msg);
             }
-            auto block_hash = silkworm::to_bytes32(block_hash_bytes.value());
-            auto block_number = co_await core::rawdb::read_header_number(tx_database, block_hash);
-            start = end = block_number;
-        } else {
-            auto latest_block_number = co_await core::get_latest_block_number(tx_database);
-            start = filter.from_block.value_or(0);
-            end = filter.to_block.value_or(latest_block_number);
         }
-        SILKRPC_INFO << "start block: " << start << " end block: " << end << "\n";
 
-        roaring::Roaring64Map block_numbers(roaring::api::roaring_bitmap_from_range(start, end+1, 1));
+        if (!error_reply) {
+            if (block_hash) {
+                auto block_number = co_await core::rawdb::read_header_number(tx_database, *block_hash);
+                start = end = block_number;
+            } else {
+                auto latest_block_number = co_await core::get_latest_block_number(tx_database);
+                start = filter.from_block.value_or(0);
+                end = filter.to_block.value_or(latest_block_number);
+            }
+            SILKRPC_INFO << "start block: " << start << " end block: " << end << "\n";
 
-        SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+            block_numbers = roaring::Roaring64Map(roaring::api::roaring_bitmap_from_range(start, end+1, 1));
 
-        if (filter.topics.has_value() && !filter.topics.value().empty()) {
-            auto topics_bitmap = co_await get_topics_bitmap(tx_database, filter.topics.value(), start, end);
-            SILKRPC_TRACE << "topics_bitmap: " << topics_bitmap.toString() << "\n";
-            if (topics_bitmap.isEmpty()) {
-                block_numbers = topics_bitmap;
-            } else {
-                block_numbers &= topics_bitmap;
+            SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+
+            if (filter.topics.has_value() && !filter.topics.value().empty()) {
+                auto topics_bitmap = co_await get_topics_bitmap(tx_database, filter.topics.value(), start, end);
+                SILKRPC_TRACE << "topics_bitmap: " << topics_bitmap.toString() << "\n";
+                if (topics_bitmap.isEmpty()) {
+                    block_numbers = topics_bitmap;
+                } else {
+                    block_numbers &= topics_bitmap;
+                }
             }
-        }
-        SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
-        SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
+            SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+            SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
 
-        if (filter.addresses.has_value()) {
-            auto addresses_bitmap = co_await get_addresses_bitmap(tx_database, filter.addresses.value(), start, end);
-            if (addresses_bitmap.isEmpty()) {
-                block_numbers = addresses_bitmap;
-            } else {
-                block_numbers &= addresses_bitmap;
+            if (filter.addresses.has_value()) {
+                auto addresses_bitmap = co_await get_addresses_bitmap(tx_database, filter.addresses.value(), start, end);
+                if (addresses_bitmap.isEmpty()) {
+                    block_numbers = addresses_bitmap;
+                } else {
+                    block_numbers &= addresses_bitmap;
+                }
             }
+            SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+            SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
         }
-        SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
-        SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
+    } catch (const std::invalid_argument& iv) {
+        SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
+        block_numbers = roaring::Roaring64Map{};
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
+        error_reply = make_json_error(request["id"], 100, e.what());
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
+        error_reply = make_json_error(request["id"], 100, "unexpected exception");
+    }
+
+    co_await tx->close(); // RAII not (yet) available with coroutines
+
+    if (error_reply) {
+        stream.write_json(*error_reply);
+        co_return;
+    }
 
-        if (block_numbers.cardinality() == 0) {
-            reply = make_json_content(request["id"], logs);
-            co_await tx->close(); // RAII not (yet) available with coroutines
+    // The logs are written as soon as they are read: an error found before anything has been sent replaces the
+    // response, after that the response is left unterminated (see below)
+    stream.open_object();
+    stream.write_field("jsonrpc", "2.0");
+    stream.write_field("id", request["id"]);
+    stream.write_field("result");
+    stream.open_array();
+
+    std::optional<std::string> error_message;
+    try {
+        co_await stream_logs(filter, block_numbers, stream);
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
+        error_message = e.what();
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
+        error_message = "unexpected exception";
+    }
+
+    if (error_message) {
+        if (!stream.flushed()) {
+            stream.reset();
+            stream.write_json(make_json_error(request["id"], 100, *error_message));
             co_return;
         }
+        // A response cannot have both result and error, and a terminated partial result would pass for a complete
+        // one: the caller must not close the stream, so that the client sees a failed transfer
+        throw std::runtime_error{*error_message};
+    }
+
+    stream.close_array();
+    stream.close_object();
+    co_return;
+}
+
+boost::asio::awaitable<void> EthereumRpcApi::stream_logs(const Filter& filter, const roaring::Roaring64Map& block_numbers, json::Stream& stream) {
+    // Chunks of blocks are read concurrently, each one in its own transaction, and their logs written in block order.
+    // The timer is only used to be woken up when any chunk completes.
+    struct LogsChunk {
+        Logs logs;
+        std::exception_ptr error;
+        bool done{false};
+    };
+    auto executor = co_await boost::asio::this_coro::executor;
+    boost::asio::steady_timer chunk_done{executor, std::chrono::steady_clock::time_point::max()};
+    std::deque<std::shared_ptr<LogsChunk>> chunks;
+
+    auto block_it = block_numbers.begin();
+    const auto spawn_next_chunk = [&]() {
+        std::vector<uint64_t> chunk_block_numbers;
+        chunk_block_numbers.reserve(kLogsChunkSize);
+        for (; block_it != block_numbers.end() && chunk_block_numbers.size() < kLogsChunkSize; ++block_it) {
+            chunk_block_numbers.push_back(*block_it);
+        }
+        if (chunk_block_numbers.empty()) {
+            return false;
+        }
+        auto chunk = std::make_shared<LogsChunk>();
+        chunks.push_back(chunk);
+        boost::asio::co_spawn(executor, read_logs_chunk(filter, std::move(chunk_block_numbers), chunk->logs),
+            [chunk, &chunk_done](std::exception_ptr error) {
+                chunk->error = error;
+                chunk->done = true;
+                chunk_done.cancel();
+            });
+        return true;
+    };
+    while (chunks.size() < kLogsMaxConcurrentChunks && spawn_next_chunk()) {}
+
+    // After an error the chunks still running are awaited anyway, they refer to the filter and the timer
+    std::exception_ptr error;
+    std::size_t logs_count{0};
+    while (!chunks.empty()) {
+        const auto chunk = chunks.front();
+        while (!chunk->done) {
+            co_await chunk_done.async_wait(boost::asio::experimental::as_tuple(boost::asio::use_awaitable));
+        }
+        chunks.pop_front();
+        if (error) {
+            continue;
+        }
+        if (chunk->error) {
+            error = chunk->error;
+            continue;
+        }
+
+        for (const auto& log : chunk->logs) {
+            stream.write_json(log);
+        }
+        logs_count += chunk->logs.size();
+        try {
+            co_await stream.flush();
+        } catch (...) {
+            error = std::current_exception();
+            continue;
+        }
+        spawn_next_chunk();
+    }
+    SILKRPC_INFO << "logs.size(): " << logs_count << "\n";
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+boost::asio::awaitable<void> EthereumRpcApi::read_logs_chunk(const Filter& filter, std::vector<uint64_t> block_numbers, Logs& logs) {
+    auto tx = co_await database_->begin();
+
+    std::exception_ptr error;
+    try {
+        ethdb::TransactionDatabase tx_database{*tx};
 
         for (auto block_to_match : block_numbers) {
             uint64_t log_index{0};
@@ -1473,33 +1622,31 @@ boost::asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann:
             SILKRPC_DEBUG << "filtered_block_logs.size(): " << filtered_block_logs.size() << "\n";
 
             if (filtered_block_logs.size() > 0) {
-                const auto block_with_hash = co_await core::read_block_by_number(*block_cache_, tx_database, block_to_match);
-                SILKRPC_DEBUG << "block_hash: " << silkworm::to_hex(block_with_hash.hash) << "\n";
+                // Only the transaction hashes are needed, not the decoded block
+                const auto block_hash = co_await core::rawdb::read_canonical_block_hash(tx_database, block_to_match);
+                const auto tx_hashes = co_await core::rawdb::read_transaction_hashes(tx_database, block_hash, block_to_match);
+                SILKRPC_DEBUG << "block_hash: " << silkworm::to_hex(block_hash) << " #tx_hashes: " << tx_hashes.size() << "\n";
                 for (auto& log : filtered_block_logs) {
-                    const auto tx_hash{hash_of_transaction(block_with_hash.block.transactions[log.tx_index])};
+                    if (log.tx_index >= tx_hashes.size()) {
+                        throw std::runtime_error{"log transaction index " + std::to_string(log.tx_index) + " out of range in block " +
+                            std::to_string(block_to_match)};
+                    }
                     log.block_number = block_to_match;
-                    log.block_hash = block_with_hash.hash;
-                    log.tx_hash = silkworm::to_bytes32({tx_hash.bytes, silkworm::kHashLength});
+                    log.block_hash = block_hash;
+                    log.tx_hash = tx_hashes[log.tx_index];
                 }
                 logs.insert(logs.end(), filtered_block_logs.begin(), filtered_block_logs.end());
             }
         }
-        SILKRPC_INFO << "logs.size(): " << logs.size() << "\n";
-
-        reply = make_json_content(request["id"], logs);
-    } catch (const std::invalid_argument& iv) {
-        SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_content(request["id"], logs);
-    } catch (const std::exception& e) {
-        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, e.what());
     } catch (...) {
-        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, "unexpected exception");
+        error = std::current_exception();
     }
 
     co_await tx->close(); // RAII not (yet) available with coroutines
-    co_return;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
 }
 
 // https://eth.wiki/json-rpc/API#eth_sendrawtransaction
@@ -32,6 +32,7 @@
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 #include <silkrpc/croaring/roaring.hh>
+#include <silkrpc/json/stream.hpp>
 #include <silkrpc/json/types.hpp>
 #include <silkrpc/ethbackend/backend.hpp>
 #include <silkrpc/ethdb/database.hpp>
@@ -95,6 +96,7 @@ protected:
     boost::asio::awaitable<void> handle_eth_get_filter_changes(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_eth_uninstall_filter(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_eth_get_logs(const nlohmann::json& request, nlohmann::json& reply);
+    boost::asio::awaitable<void> handle_eth_get_logs(const nlohmann::json& request, json::Stream& stream);
     boost::asio::awaitable<void> handle_eth_send_raw_transaction(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_eth_send_transaction(const nlohmann::json& request, nlohmann::json& reply);
     boost::asio::awaitable<void> handle_eth_sign_transaction(const nlohmann::json& request, nlohmann::json& reply);
@@ -110,6 +112,9 @@ protected:
     boost::asio::awaitable<roaring::Roaring64Map> get_topics_bitmap(core::rawdb::DatabaseReader& db_reader, FilterTopics& topics, uint64_t start, uint64_t end);
     boost::asio::awaitable<roaring::Roaring64Map> get_addresses_bitmap(core::rawdb::DatabaseReader& db_reader, FilterAddresses& addresses, uint64_t start, uint64_t end);
 
+    boost::asio::awaitable<void> stream_logs(const Filter& filter, const roaring::Roaring64Map& block_numbers, json::Stream& stream);
+    boost::asio::awaitable<void> read_logs_chunk(const Filter& filter, std::vector<uint64_t> block_numbers, Logs& logs);
+
     std::vector<Log> filter_logs(std::vector<Log>& logs, const Filter& filter);
 
     Context& context_;
@@ -36,6 +36,14 @@ std::optional<RpcApiTable::HandleMethod> RpcApiTable::find_handler(const std::st
     return handle_method_pair->second;
 }
 
+std::optional<RpcApiTable::HandleStream> RpcApiTable::find_stream_handler(const std::string& method) const {
+    const auto handle_stream_pair = stream_handlers_.find(method);
+    if (handle_stream_pair == stream_handlers_.end()) {
+        return std::nullopt;
+    }
+    return handle_stream_pair->second;
+}
+
 void RpcApiTable::build_handlers(const std::string& api_spec) {
     auto start = 0u;
     auto end = api_spec.find(kApiSpecSeparator);
@@ -117,6 +125,7 @@ void RpcApiTable::add_eth_handlers() {
     handlers_[http::method::k_eth_getFilterChanges] = &commands::RpcApi::handle_eth_get_filter_changes;
     handlers_[http::method::k_eth_uninstallFilter] = &commands::RpcApi::handle_eth_uninstall_filter;
     handlers_[http::method::k_eth_getLogs] = &commands::RpcApi::handle_eth_get_logs;
+    stream_handlers_[http::method::k_eth_getLogs] = &commands::RpcApi::handle_eth_get_logs;
     //handlers_[http::method::k_eth_sendRawTransaction] = &commands::RpcApi::handle_eth_send_raw_transaction;
     //handlers_[http::method::k_eth_sendTransaction] = &commands::RpcApi::handle_eth_send_transaction;
     handlers_[http::method::k_eth_signTransaction] = &commands::RpcApi::handle_eth_sign_transaction;
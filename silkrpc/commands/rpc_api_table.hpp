@@ -27,12 +27,14 @@
 #include <nlohmann/json.hpp>
 
 #include <silkrpc/commands/rpc_api.hpp>
+#include <silkrpc/json/stream.hpp>
 
 namespace silkrpc::commands {
 
 class RpcApiTable {
 public:
     typedef boost::asio::awaitable<void> (RpcApi::*HandleMethod)(const nlohmann::json&, nlohmann::json&);
+    typedef boost::asio::awaitable<void> (RpcApi::*HandleStream)(const nlohmann::json&, json::Stream&);
 
     explicit RpcApiTable(const std::string& api_spec);
 
@@ -41,6 +43,9 @@ public:
 
     std::optional<HandleMethod> find_handler(const std::string& method) const;
 
+    //! Find the handler writing the whole response of the method into a stream, if any
+    std::optional<HandleStream> find_stream_handler(const std::string& method) const;
+
 private:
     void build_handlers(const std::string& api_spec);
     void add_handlers(const std::string& api_namespace);
@@ -55,6 +60,7 @@ private:
     void add_txpool_handlers();
 
     std::map<std::string, HandleMethod> handlers_;
+    std::map<std::string, HandleStream> stream_handlers_;
 };
 
 } // namespace silkrpc::commands
@@ -19,6 +19,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 
 namespace silkrpc {
 
@@ -42,6 +43,12 @@ constexpr const char* kDefaultTarget{"localhost:9090"};
 constexpr const char* kDefaultEth1ApiSpec{"debug,eth,net,parity,erigon,trace,web3,txpool"};
 constexpr const char* kDefaultEth2ApiSpec{"engine,eth"};
 constexpr const std::chrono::milliseconds kDefaultTimeout{10000};
+constexpr const std::size_t kDefaultMaxBatchSize{100};
+constexpr const uint32_t kDefaultMaxReaders{16};
+constexpr const uint32_t kDefaultMaxCursorReadAhead{256};
+
+constexpr const std::size_t kLogsChunkSize{100};
+constexpr const std::size_t kLogsMaxConcurrentChunks{4};
 
 constexpr const std::size_t kHttpIncomingBufferSize{8192};
 
@@ -0,0 +1,57 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_WRITER_HPP_
+#define SILKRPC_COMMON_WRITER_HPP_
+
+#include <string>
+#include <string_view>
+
+#include <silkrpc/config.hpp>
+
+#include <boost/asio/awaitable.hpp>
+
+namespace silkrpc {
+
+//! Sink of content produced incrementally, e.g. a response sent while it is being built
+class Writer {
+public:
+    virtual ~Writer() = default;
+
+    virtual boost::asio::awaitable<void> write(std::string_view content) = 0;
+
+    virtual boost::asio::awaitable<void> close() { co_return; }
+};
+
+//! Writer collecting all the content in memory
+class StringWriter : public Writer {
+public:
+    StringWriter() = default;
+
+    boost::asio::awaitable<void> write(std::string_view content) override {
+        content_.append(content);
+        co_return;
+    }
+
+    const std::string& content() const { return content_; }
+
+private:
+    std::string content_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_WRITER_HPP_
@@ -22,6 +22,7 @@
 
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/ethbackend/remote_backend.hpp>
+#include <silkrpc/ethdb/file/local_database.hpp>
 #include <silkrpc/ethdb/kv/remote_database.hpp>
 
 namespace silkrpc {
@@ -35,7 +36,9 @@ Context::Context(
     ChannelFactory create_channel,
     std::shared_ptr<BlockCache> block_cache,
     std::shared_ptr<ethdb::kv::StateCache> state_cache,
-    WaitMode wait_mode)
+    WaitMode wait_mode,
+    std::shared_ptr<mdbx::env_managed> chaindata_env,
+    uint32_t max_cursor_read_ahead)
     : io_context_{std::make_shared<boost::asio::io_context>()},
       io_context_work_{boost::asio::make_work_guard(*io_context_)},
       grpc_context_{std::make_unique<agrpc::GrpcContext>(std::make_unique<grpc::CompletionQueue>())},
@@ -44,7 +47,11 @@ Context::Context(
       state_cache_(state_cache),
       wait_mode_(wait_mode) {
     std::shared_ptr<grpc::Channel> channel = create_channel();
-    database_ = std::make_unique<ethdb::kv::RemoteDatabase>(*grpc_context_, channel);
+    if (chaindata_env) {
+        database_ = std::make_unique<ethdb::file::LocalDatabase>(chaindata_env);
+    } else {
+        database_ = std::make_unique<ethdb::kv::RemoteDatabase>(*grpc_context_, channel, max_cursor_read_ahead);
+    }
     backend_ = std::make_unique<ethbackend::RemoteBackEnd>(*io_context_, channel, *grpc_context_);
     miner_ = std::make_unique<txpool::Miner>(*io_context_, channel, *grpc_context_);
     tx_pool_ = std::make_unique<txpool::TransactionPool>(*io_context_, channel, *grpc_context_);
@@ -108,7 +115,8 @@ void Context::stop() {
     SILKRPC_DEBUG << "Context::stop io_context " << io_context_ << " [" << this << "]\n";
 }
 
-ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode) : next_index_{0} {
+ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode,
+                         std::shared_ptr<mdbx::env_managed> chaindata_env, uint32_t max_cursor_read_ahead) : next_index_{0} {
     if (pool_size == 0) {
         throw std::logic_error("ContextPool::ContextPool pool_size is 0");
     }
@@ -122,7 +130,7 @@ ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, W
 
     // Create as many execution contexts as required by the pool size
     for (std::size_t i{0}; i < pool_size; ++i) {
-        contexts_.emplace_back(Context{create_channel, block_cache, state_cache, wait_mode});
+        contexts_.emplace_back(Context{create_channel, block_cache, state_cache, wait_mode, chaindata_env, max_cursor_read_ahead});
         SILKRPC_DEBUG << "ContextPool::ContextPool context[" << i << "] " << contexts_[i] << "\n";
     }
 }
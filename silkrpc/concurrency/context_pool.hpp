@@ -29,8 +29,10 @@
 #include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
 #include <grpcpp/grpcpp.h>
+#include <mdbx.h++>
 
 #include <silkrpc/common/block_cache.hpp>
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/concurrency/wait_strategy.hpp>
 #include <silkrpc/ethbackend/backend.hpp>
@@ -50,7 +52,9 @@ class Context {
         ChannelFactory create_channel,
         std::shared_ptr<BlockCache> block_cache,
         std::shared_ptr<ethdb::kv::StateCache> state_cache,
-        WaitMode wait_mode = WaitMode::blocking);
+        WaitMode wait_mode = WaitMode::blocking,
+        std::shared_ptr<mdbx::env_managed> chaindata_env = {},
+        uint32_t max_cursor_read_ahead = kDefaultMaxCursorReadAhead);
 
     boost::asio::io_context* io_context() const noexcept { return io_context_.get(); }
     grpc::CompletionQueue* grpc_queue() const noexcept { return grpc_context_->get_completion_queue(); }
@@ -104,7 +108,9 @@ std::ostream& operator<<(std::ostream& out, Context& c);
 // [currently cannot start/stop more than once because grpc::CompletionQueue cannot be used after shutdown]
 class ContextPool {
 public:
-    explicit ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode = WaitMode::blocking);
+    explicit ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode = WaitMode::blocking,
+                         std::shared_ptr<mdbx::env_managed> chaindata_env = {},
+                         uint32_t max_cursor_read_ahead = kDefaultMaxCursorReadAhead);
     ~ContextPool();
 
     ContextPool(const ContextPool&) = delete;
@@ -122,6 +128,10 @@ public:
 
     boost::asio::io_context& next_io_context();
 
+    std::size_t size() const noexcept { return contexts_.size(); }
+
+    Context& context(std::size_t index) { return contexts_.at(index); }
+
 private:
     // The pool of contexts
     std::vector<Context> contexts_;
@@ -358,4 +358,48 @@ boost::asio::awaitable<Transactions> read_transactions(const DatabaseReader& rea
     co_return txns;
 }
 
+boost::asio::awaitable<std::vector<evmc::bytes32>> read_transaction_hashes(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number) {
+    const auto data = co_await read_body_rlp(reader, block_hash, block_number);
+    if (data.empty()) {
+        throw std::runtime_error{"empty block body RLP in read_transaction_hashes"};
+    }
+    silkworm::db::detail::BlockBodyForStorage stored_body;
+    try {
+        silkworm::ByteView data_view{data};
+        stored_body = silkworm::db::detail::decode_stored_block_body(data_view);
+    } catch (silkworm::rlp::DecodingError error) {
+        SILKRPC_ERROR << "RLP decoding error for block body #" << block_number << " [" << error.what() << "]\n";
+        throw std::runtime_error{"RLP decoding error for block body [" + std::string(error.what()) + "]"};
+    }
+
+    std::vector<evmc::bytes32> hashes;
+    if (stored_body.txn_count == 0) {
+        co_return hashes;
+    }
+    hashes.reserve(stored_body.txn_count);
+
+    silkworm::Bytes txn_id_key(8, '\0');
+    boost::endian::store_big_u64(&txn_id_key[0], stored_body.base_txn_id);
+    Walker walker = [&](const silkworm::Bytes&, const silkworm::Bytes& v) {
+        // Legacy transactions are stored as the RLP list which is hashed to identify them, typed ones (EIP-2718) are
+        // wrapped into an RLP string whose payload, i.e. type byte followed by the RLP list, is the hashed encoding
+        silkworm::ByteView tx_rlp{v};
+        if (!tx_rlp.empty() && tx_rlp[0] < 0xc0) {
+            const auto [header, err]{silkworm::rlp::decode_header(tx_rlp)};
+            if (err != silkworm::DecodingResult::kOk || header.list || header.payload_length > tx_rlp.size()) {
+                throw std::runtime_error{"invalid transaction RLP in read_transaction_hashes"};
+            }
+            tx_rlp = tx_rlp.substr(0, header.payload_length);
+        }
+        const auto tx_hash{hash_of(tx_rlp)};
+        hashes.push_back(silkworm::to_bytes32({tx_hash.bytes, silkworm::kHashLength}));
+        return hashes.size() < stored_body.txn_count;
+    };
+    co_await reader.walk(db::table::kEthTx, txn_id_key, 0, walker);
+
+    SILKRPC_DEBUG << "#hashes: " << hashes.size() << "\n";
+
+    co_return hashes;
+}
+
 } // namespace silkrpc::core::rawdb
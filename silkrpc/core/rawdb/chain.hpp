@@ -80,6 +80,9 @@ boost::asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, con
 
 boost::asio::awaitable<Transactions> read_transactions(const DatabaseReader& reader, uint64_t base_txn_id, uint64_t txn_count);
 
+//! Read the hashes of the transactions in the block, hashing their stored RLP without decoding them
+boost::asio::awaitable<std::vector<evmc::bytes32>> read_transaction_hashes(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number);
+
 } // namespace silkrpc::core::rawdb
 
 #endif  // SILKRPC_CORE_RAWDB_CHAIN_HPP_
@@ -1430,4 +1430,65 @@ TEST_CASE("read_transactions") {
     }
 }
 
+TEST_CASE("read_transaction_hashes") {
+    boost::asio::thread_pool pool{1};
+    MockDatabaseReader db_reader;
+    const auto block_hash{0x439816753229fc0736bf86a5048de4bc9fcdede8c91dadf88c828c76b2281dff_bytes32};
+    const uint64_t block_number{4'000'000};
+
+    SECTION("block body not found") {
+        EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
+            []() -> boost::asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
+        auto result = boost::asio::co_spawn(pool, read_transaction_hashes(db_reader, block_hash, block_number), boost::asio::use_future);
+        CHECK_THROWS_MATCHES(result.get(), std::runtime_error, Message("empty block body RLP in read_transaction_hashes"));
+    }
+
+    SECTION("invalid block body") {
+        EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
+            []() -> boost::asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{0x00, 0x01}}; }
+        ));
+        auto result = boost::asio::co_spawn(pool, read_transaction_hashes(db_reader, block_hash, block_number), boost::asio::use_future);
+        CHECK_THROWS_AS(result.get(), std::runtime_error);
+    }
+
+    SECTION("block with transaction") {
+        EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
+            []() -> boost::asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kNotEmptyBody}; }
+        ));
+        EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(Invoke(
+            [](Unused, Unused, Unused, Walker w) -> boost::asio::awaitable<void> {
+                silkworm::Bytes key{};
+                silkworm::Bytes value{*silkworm::from_hex("f8ac8301942e8477359400834c4b40945f62669ba0c6cf41cc162d8157ed71a0b9d6dbaf80b844f2"
+                    "f0387700000000000000000000000000000000000000000000000000000000000158b09f0270fc889c577c1c64db7c819f921d"
+                    "1b6e8c7e5d3f2ff34f162cf4b324cc052ea0d5494ad16e2233197daa9d54cbbcb1ee534cf9f675fa587c264a4ce01e7d3d23a0"
+                    "1421bcf57f4b39eb84a35042dc4675ae167f3e2f50e808252afa23e62e692355")};
+                w(key, value);
+                co_return;
+            }
+        ));
+        auto result = boost::asio::co_spawn(pool, read_transaction_hashes(db_reader, block_hash, block_number), boost::asio::use_future);
+        CHECK(result.get() == std::vector<evmc::bytes32>{0x3ff7b8917f1941784c709d6e54db18500fddc2b4c1a90b5cdec675cd0f9fc042_bytes32});
+    }
+
+    SECTION("block with typed transaction") {
+        EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
+            []() -> boost::asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kNotEmptyBody}; }
+        ));
+        EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(Invoke(
+            [](Unused, Unused, Unused, Walker w) -> boost::asio::awaitable<void> {
+                // EIP-1559 transaction wrapped into an RLP string as stored
+                silkworm::Bytes key{};
+                silkworm::Bytes value{*silkworm::from_hex("b87602f873058207e98459682f008459682f0a82520894861ca2f5ff2e03f90d2c3e"
+                    "afda88752fbffc6a6987470de4df82000080c001a0b6809d941f0c51652eaeefeaabe769ecf20e2ecbc2e2a0f8ffb79674a7dd"
+                    "323ea05a0c7018dba31912dd177d78a11b917be460faad27ca937e66b663abc8e131b9")};
+                w(key, value);
+                co_return;
+            }
+        ));
+        auto result = boost::asio::co_spawn(pool, read_transaction_hashes(db_reader, block_hash, block_number), boost::asio::use_future);
+        CHECK(result.get() == std::vector<evmc::bytes32>{0xd692803b1bf96e2591da786ccb4c13f617edce9c8a4471053e92c1ef0e50824c_bytes32});
+    }
+}
+
 } // namespace silkrpc::core::rawdb
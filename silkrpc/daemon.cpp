@@ -25,6 +25,8 @@
 #include <boost/process/environment.hpp>
 #include <grpcpp/grpcpp.h>
 
+#include <silkrpc/ethdb/file/local_database.hpp>
+
 namespace silkrpc {
 
 // The maximum receive message in bytes for gRPC channels.
@@ -167,12 +169,33 @@ bool Daemon::validate_settings(const DaemonSettings& settings) {
     }
 
     const auto num_contexts = settings.num_contexts;
-    if (num_contexts < 0) {
+    if (num_contexts == 0) {
         SILKRPC_ERROR << "Parameter num_contexts is invalid: [" << num_contexts << "]\n";
         SILKRPC_ERROR << "Use --num_contexts flag to specify the number of threads running I/O contexts\n";
         return false;
     }
 
+    const auto max_batch_size = settings.max_batch_size;
+    if (max_batch_size == 0) {
+        SILKRPC_ERROR << "Parameter max_batch_size is invalid: [" << max_batch_size << "]\n";
+        SILKRPC_ERROR << "Use --max_batch_size flag to specify the maximum number of requests in a JSON RPC batch\n";
+        return false;
+    }
+
+    const auto max_readers = settings.max_readers;
+    if (!chaindata.empty() && max_readers == 0) {
+        SILKRPC_ERROR << "Parameter max_readers is invalid: [" << max_readers << "]\n";
+        SILKRPC_ERROR << "Use --max_readers flag to specify the maximum number of chaindata readers\n";
+        return false;
+    }
+
+    const auto max_cursor_read_ahead = settings.max_cursor_read_ahead;
+    if (max_cursor_read_ahead == 0) {
+        SILKRPC_ERROR << "Parameter max_cursor_read_ahead is invalid: [" << max_cursor_read_ahead << "]\n";
+        SILKRPC_ERROR << "Use --max_cursor_read_ahead flag to specify the max records read ahead by cursors (1 disables it)\n";
+        return false;
+    }
+
     const auto num_workers = settings.num_workers;
     if (num_workers < 0) {
         SILKRPC_ERROR << "Parameter num_workers is invalid: [" << num_workers << "]\n";
@@ -197,7 +220,8 @@ ChannelFactory Daemon::make_channel_factory(const DaemonSettings& settings) {
 Daemon::Daemon(const DaemonSettings& settings)
     : settings_(settings),
       create_channel_{make_channel_factory(settings_)},
-      context_pool_{settings_.num_contexts, create_channel_, settings_.wait_mode},
+      chaindata_env_{settings_.chaindata.empty() ? nullptr : ethdb::file::open_chaindata_env(settings_.chaindata, settings_.max_readers)},
+      context_pool_{settings_.num_contexts, create_channel_, settings_.wait_mode, chaindata_env_, settings_.max_cursor_read_ahead},
       worker_pool_{settings_.num_workers},
       kv_stub_{remote::KV::NewStub(create_channel_())} {
     // Create the unique KV state-changes stream feeding the state cache
@@ -216,12 +240,22 @@ DaemonChecklist Daemon::run_checklist() {
 }
 
 void Daemon::start() {
-    for (int i = 0; i < settings_.num_contexts; ++i) {
-        auto& context = context_pool_.next_context();
+    if (settings_.http_round_robin) {
+        // Spreads connections evenly also where SO_REUSEPORT does not balance them (e.g. macOS) or when a few
+        // long-lived connections would hash to the same acceptor
         rpc_services_.emplace_back(
-            std::make_unique<http::Server>(settings_.http_port, settings_.api_spec, context, worker_pool_));
+            std::make_unique<http::Server>(settings_.http_port, settings_.api_spec, context_pool_, worker_pool_, settings_.max_batch_size));
         rpc_services_.emplace_back(
-            std::make_unique<http::Server>(settings_.engine_port, kDefaultEth2ApiSpec, context, worker_pool_));
+            std::make_unique<http::Server>(settings_.engine_port, kDefaultEth2ApiSpec, context_pool_, worker_pool_, settings_.max_batch_size));
+    } else {
+        // One SO_REUSEPORT acceptor per context, the kernel spreads incoming connections among them
+        for (int i = 0; i < settings_.num_contexts; ++i) {
+            auto& context = context_pool_.next_context();
+            rpc_services_.emplace_back(
+                std::make_unique<http::Server>(settings_.http_port, settings_.api_spec, context, worker_pool_, settings_.max_batch_size));
+            rpc_services_.emplace_back(
+                std::make_unique<http::Server>(settings_.engine_port, kDefaultEth2ApiSpec, context, worker_pool_, settings_.max_batch_size));
+        }
     }
 
     for (auto& service : rpc_services_) {
@@ -43,6 +43,10 @@ struct DaemonSettings {
     uint32_t num_workers;
     LogLevel log_verbosity;
     WaitMode wait_mode;
+    uint32_t max_batch_size{kDefaultMaxBatchSize};
+    bool http_round_robin{false}; // one acceptor handing connections to every context instead of one acceptor per context
+    uint32_t max_readers{kDefaultMaxReaders}; // max number of MDBX readers when reading chaindata in process
+    uint32_t max_cursor_read_ahead{kDefaultMaxCursorReadAhead}; // max records read ahead in one round trip by remote cursors
 };
 
 struct DaemonInfo {
@@ -82,6 +86,9 @@ class Daemon {
     //! The factory of gRPC client-side channels.
     ChannelFactory create_channel_;
 
+    //! The chaindata MDBX environment read in process, if any (otherwise the remote KV interface is used).
+    std::shared_ptr<mdbx::env_managed> chaindata_env_;
+
     //! The execution contexts capturing the asynchronous scheduling model.
     ContextPool context_pool_;
 
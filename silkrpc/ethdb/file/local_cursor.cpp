@@ -0,0 +1,86 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#include "local_cursor.hpp"
+
+#include <silkrpc/common/clock_time.hpp>
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc::ethdb::file {
+
+inline mdbx::slice to_slice(silkworm::ByteView view) {
+    return mdbx::slice{view.data(), view.length()};
+}
+
+inline silkworm::Bytes to_bytes(const mdbx::slice& slice) {
+    return silkworm::Bytes{slice.byte_ptr(), slice.length()};
+}
+
+inline KeyValue to_key_value(const mdbx::cursor::move_result& result) {
+    if (!result.done) {
+        return KeyValue{};
+    }
+    return KeyValue{to_bytes(result.key), to_bytes(result.value)};
+}
+
+boost::asio::awaitable<void> LocalCursor::open_cursor(const std::string& table_name) {
+    const auto start_time = clock_time::now();
+    if (!cursor_) {
+        // Accede to the table flags (e.g. dup-sort) as created by the writer
+        MDBX_dbi dbi{0};
+        mdbx::error::success_or_throw(::mdbx_dbi_open(txn_, table_name.c_str(), MDBX_DB_ACCEDE, &dbi));
+        cursor_ = txn_.open_cursor(mdbx::map_handle{dbi});
+    }
+    SILKRPC_DEBUG << "LocalCursor::open_cursor [" << table_name << "] c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return;
+}
+
+boost::asio::awaitable<KeyValue> LocalCursor::seek(silkworm::ByteView key) {
+    SILKRPC_DEBUG << "LocalCursor::seek cursor: " << cursor_id_ << " key: " << key << "\n";
+    const auto result = key.empty() ? cursor_.to_first(/*throw_notfound=*/false) : cursor_.lower_bound(to_slice(key), /*throw_notfound=*/false);
+    co_return to_key_value(result);
+}
+
+boost::asio::awaitable<KeyValue> LocalCursor::seek_exact(silkworm::ByteView key) {
+    SILKRPC_DEBUG << "LocalCursor::seek_exact cursor: " << cursor_id_ << " key: " << key << "\n";
+    co_return to_key_value(cursor_.find(to_slice(key), /*throw_notfound=*/false));
+}
+
+boost::asio::awaitable<KeyValue> LocalCursor::next() {
+    co_return to_key_value(cursor_.to_next(/*throw_notfound=*/false));
+}
+
+boost::asio::awaitable<silkworm::Bytes> LocalCursor::seek_both(silkworm::ByteView key, silkworm::ByteView value) {
+    SILKRPC_DEBUG << "LocalCursor::seek_both cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
+    const auto result = cursor_.lower_bound_multivalue(to_slice(key), to_slice(value), /*throw_notfound=*/false);
+    co_return to_key_value(result).value;
+}
+
+boost::asio::awaitable<KeyValue> LocalCursor::seek_both_exact(silkworm::ByteView key, silkworm::ByteView value) {
+    SILKRPC_DEBUG << "LocalCursor::seek_both_exact cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
+    co_return to_key_value(cursor_.find_multivalue(to_slice(key), to_slice(value), /*throw_notfound=*/false));
+}
+
+boost::asio::awaitable<void> LocalCursor::close_cursor() {
+    if (cursor_) {
+        cursor_.close();
+    }
+    SILKRPC_DEBUG << "LocalCursor::close_cursor c=" << cursor_id_ << "\n";
+    co_return;
+}
+
+} // namespace silkrpc::ethdb::file
@@ -0,0 +1,55 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef SILKRPC_ETHDB_FILE_LOCAL_DATABASE_HPP_
+#define SILKRPC_ETHDB_FILE_LOCAL_DATABASE_HPP_
+
+#include <memory>
+#include <string>
+
+#include <silkrpc/config.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <mdbx.h++>
+
+#include <silkrpc/ethdb/database.hpp>
+#include <silkrpc/ethdb/transaction.hpp>
+
+namespace silkrpc::ethdb::file {
+
+//! Open the chaindata MDBX environment at the specified path in read-only mode, shared with the process writing it
+std::shared_ptr<mdbx::env_managed> open_chaindata_env(const std::string& chaindata, uint32_t max_readers);
+
+//! Database reading the chaindata MDBX environment in process, instead of through the remote KV interface
+class LocalDatabase: public Database {
+public:
+    explicit LocalDatabase(std::shared_ptr<mdbx::env_managed> chaindata_env);
+
+    ~LocalDatabase();
+
+    LocalDatabase(const LocalDatabase&) = delete;
+    LocalDatabase& operator=(const LocalDatabase&) = delete;
+
+    boost::asio::awaitable<std::unique_ptr<Transaction>> begin() override;
+
+private:
+    std::shared_ptr<mdbx::env_managed> chaindata_env_;
+};
+
+} // namespace silkrpc::ethdb::file
+
+#endif  // SILKRPC_ETHDB_FILE_LOCAL_DATABASE_HPP_
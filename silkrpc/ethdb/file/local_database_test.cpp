@@ -0,0 +1,120 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "local_database.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkrpc::ethdb::file {
+
+// Temporary MDBX environment holding one plain and one dup-sort table
+struct LocalDatabaseTest {
+    LocalDatabaseTest() {
+        std::filesystem::create_directories(path_);
+        silkworm::db::EnvConfig config{path_.string()};
+        config.create = true;
+        config.max_size = 16 * 1024 * 1024;
+        config.growth_size = 1024 * 1024;
+        env_ = std::make_shared<mdbx::env_managed>(silkworm::db::open_env(config));
+
+        auto txn = env_->start_write();
+        auto plain = txn.create_map("Plain", mdbx::key_mode::usual, mdbx::value_mode::single);
+        txn.upsert(plain, mdbx::slice{"01"}, mdbx::slice{"a"});
+        txn.upsert(plain, mdbx::slice{"03"}, mdbx::slice{"c"});
+        auto dup_sort = txn.create_map("DupSort", mdbx::key_mode::usual, mdbx::value_mode::multi);
+        txn.upsert(dup_sort, mdbx::slice{"k"}, mdbx::slice{"10"});
+        txn.upsert(dup_sort, mdbx::slice{"k"}, mdbx::slice{"30"});
+        txn.commit();
+    }
+
+    ~LocalDatabaseTest() {
+        env_.reset();
+        std::filesystem::remove_all(path_);
+    }
+
+    template <typename T>
+    T spawn_and_wait(boost::asio::awaitable<T>&& awaitable) {
+        return boost::asio::co_spawn(pool_, std::move(awaitable), boost::asio::use_future).get();
+    }
+
+    std::filesystem::path path_{std::filesystem::temp_directory_path() / "silkrpc_local_database_test"};
+    std::shared_ptr<mdbx::env_managed> env_;
+    // One thread only, MDBX read-only transactions cannot move across threads
+    boost::asio::thread_pool pool_{1};
+};
+
+static silkworm::Bytes bytes(const std::string& s) {
+    return silkworm::Bytes{reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+TEST_CASE_METHOD(LocalDatabaseTest, "LocalDatabase::begin", "[silkrpc][ethdb][file][local_database]") {
+    LocalDatabase database{env_};
+    const auto txn = spawn_and_wait(database.begin());
+    CHECK(txn->tx_id() != 0);
+    spawn_and_wait(txn->close());
+    CHECK(txn->tx_id() == 0);
+}
+
+TEST_CASE_METHOD(LocalDatabaseTest, "LocalCursor", "[silkrpc][ethdb][file][local_cursor]") {
+    LocalDatabase database{env_};
+    const auto txn = spawn_and_wait(database.begin());
+
+    SECTION("seek and next") {
+        const auto cursor = spawn_and_wait(txn->cursor("Plain"));
+        auto kv = spawn_and_wait(cursor->seek(bytes("02")));
+        CHECK(kv.key == bytes("03"));
+        CHECK(kv.value == bytes("c"));
+        kv = spawn_and_wait(cursor->seek({}));
+        CHECK(kv.key == bytes("01"));
+        kv = spawn_and_wait(cursor->next());
+        CHECK(kv.key == bytes("03"));
+        kv = spawn_and_wait(cursor->next());
+        CHECK(kv.key.empty());
+        CHECK(kv.value.empty());
+    }
+
+    SECTION("seek_exact") {
+        const auto cursor = spawn_and_wait(txn->cursor("Plain"));
+        CHECK(spawn_and_wait(cursor->seek_exact(bytes("01"))).value == bytes("a"));
+        CHECK(spawn_and_wait(cursor->seek_exact(bytes("02"))).value.empty());
+    }
+
+    SECTION("seek_both and seek_both_exact") {
+        const auto cursor = spawn_and_wait(txn->cursor_dup_sort("DupSort"));
+        CHECK(spawn_and_wait(cursor->seek_both(bytes("k"), bytes("20"))) == bytes("30"));
+        CHECK(spawn_and_wait(cursor->seek_both(bytes("k"), bytes("40"))).empty());
+        CHECK(spawn_and_wait(cursor->seek_both_exact(bytes("k"), bytes("10"))).value == bytes("10"));
+        CHECK(spawn_and_wait(cursor->seek_both_exact(bytes("k"), bytes("20"))).key.empty());
+    }
+
+    SECTION("cursor reused by table") {
+        const auto cursor1 = spawn_and_wait(txn->cursor("Plain"));
+        const auto cursor2 = spawn_and_wait(txn->cursor("Plain"));
+        CHECK(cursor1 == cursor2);
+    }
+
+    spawn_and_wait(txn->close());
+}
+
+} // namespace silkrpc::ethdb::file
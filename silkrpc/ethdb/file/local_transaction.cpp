@@ -0,0 +1,65 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#include "local_transaction.hpp"
+
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc::ethdb::file {
+
+LocalTransaction::LocalTransaction(mdbx::env& chaindata_env) : chaindata_env_{chaindata_env} {
+}
+
+LocalTransaction::~LocalTransaction() {
+}
+
+boost::asio::awaitable<void> LocalTransaction::open() {
+    txn_ = chaindata_env_.start_read();
+    // The MDBX transaction ID is the same view ID of the remote KV interface, so the state cache stays coherent
+    tx_id_ = txn_.id();
+    co_return;
+}
+
+boost::asio::awaitable<std::shared_ptr<Cursor>> LocalTransaction::cursor(const std::string& table) {
+    co_return co_await get_cursor(table);
+}
+
+boost::asio::awaitable<std::shared_ptr<CursorDupSort>> LocalTransaction::cursor_dup_sort(const std::string& table) {
+    co_return co_await get_cursor(table);
+}
+
+boost::asio::awaitable<void> LocalTransaction::close() {
+    cursors_.clear();
+    if (txn_) {
+        txn_.abort();
+    }
+    tx_id_ = 0;
+    co_return;
+}
+
+boost::asio::awaitable<std::shared_ptr<CursorDupSort>> LocalTransaction::get_cursor(const std::string& table) {
+    auto cursor_it = cursors_.find(table);
+    if (cursor_it != cursors_.end()) {
+        co_return cursor_it->second;
+    }
+    auto cursor = std::make_shared<LocalCursor>(txn_, cursors_.size() + 1);
+    co_await cursor->open_cursor(table);
+    cursors_[table] = cursor;
+    co_return cursor;
+}
+
+} // namespace silkrpc::ethdb::file
@@ -36,6 +36,7 @@ boost::asio::awaitable<void> RemoteCursor::open_cursor(const std::string& table_
 
 boost::asio::awaitable<KeyValue> RemoteCursor::seek(silkworm::ByteView key) {
     const auto start_time = clock_time::now();
+    reset_read_ahead();
     SILKRPC_DEBUG << "RemoteCursor::seek cursor: " << cursor_id_ << " key: " << key << "\n";
     auto seek_message = remote::Cursor{};
     seek_message.set_op(remote::Op::SEEK);
@@ -50,6 +51,7 @@ boost::asio::awaitable<KeyValue> RemoteCursor::seek(silkworm::ByteView key) {
 
 boost::asio::awaitable<KeyValue> RemoteCursor::seek_exact(silkworm::ByteView key) {
     const auto start_time = clock_time::now();
+    reset_read_ahead();
     SILKRPC_DEBUG << "RemoteCursor::seek_exact cursor: " << cursor_id_ << " key: " << key << "\n";
     auto seek_message = remote::Cursor{};
     seek_message.set_op(remote::Op::SEEK_EXACT);
@@ -64,18 +66,45 @@ boost::asio::awaitable<KeyValue> RemoteCursor::seek_exact(silkworm::ByteView key
 
 boost::asio::awaitable<KeyValue> RemoteCursor::next() {
     const auto start_time = clock_time::now();
+    if (read_ahead_records_.empty()) {
+        co_await read_ahead(read_ahead_window_);
+        // The cursor keeps advancing, likely scanning a range: read more records in the next round trip
+        read_ahead_window_ = std::min(read_ahead_window_ * 2, max_read_ahead_);
+    }
+    auto kv = std::move(read_ahead_records_.front());
+    read_ahead_records_.pop_front();
+    SILKRPC_DEBUG << "RemoteCursor::next k: " << kv.key << " v: " << kv.value << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return kv;
+}
+
+boost::asio::awaitable<void> RemoteCursor::read_ahead(uint32_t count) {
     auto next_message = remote::Cursor{};
     next_message.set_op(remote::Op::NEXT);
     next_message.set_cursor(cursor_id_);
-    auto next_pair = co_await tx_rpc_.write_and_read(next_message);
-    const auto k = silkworm::bytes_of_string(next_pair.k());
-    const auto v = silkworm::bytes_of_string(next_pair.v());
-    SILKRPC_DEBUG << "RemoteCursor::next k: " << k << " v: " << v << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
-    co_return KeyValue{k, v};
+    // The replies come back in order on the stream, so all the requests are written before reading the first reply
+    for (uint32_t i{0}; i < count; ++i) {
+        co_await tx_rpc_.write(next_message);
+    }
+    bool end_reached{false};
+    for (uint32_t i{0}; i < count; ++i) {
+        auto next_pair = co_await tx_rpc_.read();
+        // Every reply must be read to keep the stream in sync, but the ones past the end of the table are useless
+        if (end_reached) continue;
+        auto k = silkworm::bytes_of_string(next_pair.k());
+        end_reached = k.empty();
+        read_ahead_records_.push_back(KeyValue{std::move(k), silkworm::bytes_of_string(next_pair.v())});
+    }
+    SILKRPC_DEBUG << "RemoteCursor::read_ahead c=" << cursor_id_ << " count=" << count << " read=" << read_ahead_records_.size() << "\n";
+}
+
+void RemoteCursor::reset_read_ahead() {
+    read_ahead_records_.clear();
+    read_ahead_window_ = 1;
 }
 
 boost::asio::awaitable<silkworm::Bytes> RemoteCursor::seek_both(silkworm::ByteView key, silkworm::ByteView value) {
     const auto start_time = clock_time::now();
+    reset_read_ahead();
     SILKRPC_DEBUG << "RemoteCursor::seek_both cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
     auto seek_message = remote::Cursor{};
     seek_message.set_op(remote::Op::SEEK_BOTH);
@@ -91,6 +120,7 @@ boost::asio::awaitable<silkworm::Bytes> RemoteCursor::seek_both(silkworm::ByteVi
 
 boost::asio::awaitable<KeyValue> RemoteCursor::seek_both_exact(silkworm::ByteView key, silkworm::ByteView value) {
     const auto start_time = clock_time::now();
+    reset_read_ahead();
     SILKRPC_DEBUG << "RemoteCursor::seek_both_exact cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
     auto seek_message = remote::Cursor{};
     seek_message.set_op(remote::Op::SEEK_BOTH_EXACT);
@@ -107,6 +137,7 @@ boost::asio::awaitable<KeyValue> RemoteCursor::seek_both_exact(silkworm::ByteVie
 boost::asio::awaitable<void> RemoteCursor::close_cursor() {
     const auto start_time = clock_time::now();
     const auto cursor_id = cursor_id_;
+    reset_read_ahead();
     if (cursor_id_ != 0) {
         SILKRPC_DEBUG << "RemoteCursor::close_cursor closing cursor: " << cursor_id_ << "\n";
         auto close_message = remote::Cursor{};
@@ -17,6 +17,8 @@
 #ifndef SILKRPC_ETHDB_KV_REMOTE_CURSOR_HPP_
 #define SILKRPC_ETHDB_KV_REMOTE_CURSOR_HPP_
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -27,6 +29,7 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/use_awaitable.hpp>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/common/util.hpp>
 #include <silkrpc/ethdb/cursor.hpp>
@@ -35,9 +38,12 @@
 
 namespace silkrpc::ethdb::kv {
 
+//! Cursor on the remote KV interface. Consecutive next calls read ahead a window of records in one round trip: the window
+//! doubles at each call up to the max read-ahead and restarts from one record at each seek. Max read-ahead 1 disables it.
 class RemoteCursor : public CursorDupSort {
 public:
-    explicit RemoteCursor(TxRpc& tx_rpc) : tx_rpc_(tx_rpc), cursor_id_{0} {}
+    explicit RemoteCursor(TxRpc& tx_rpc, uint32_t max_read_ahead = kDefaultMaxCursorReadAhead)
+        : tx_rpc_(tx_rpc), cursor_id_{0}, max_read_ahead_{std::max(max_read_ahead, 1u)} {}
 
     uint32_t cursor_id() const override { return cursor_id_; };
 
@@ -56,8 +62,17 @@ public:
     boost::asio::awaitable<KeyValue> seek_both_exact(silkworm::ByteView key, silkworm::ByteView value) override;
 
 private:
+    //! Pipeline count NEXT requests on the stream and buffer their replies
+    boost::asio::awaitable<void> read_ahead(uint32_t count);
+
+    //! Drop the records read ahead, the cursor is going to be positioned elsewhere
+    void reset_read_ahead();
+
     TxRpc& tx_rpc_;
     uint32_t cursor_id_;
+    uint32_t max_read_ahead_;
+    uint32_t read_ahead_window_{1};
+    std::deque<KeyValue> read_ahead_records_;
 };
 
 } // namespace silkrpc::ethdb::kv
@@ -630,4 +630,51 @@ TEST_CASE_METHOD(RemoteCursorTest, "RemoteCursor::seek_both_exact", "[silkrpc][e
     }
 }
 
+TEST_CASE_METHOD(RemoteCursorTest, "RemoteCursor::next read ahead", "[silkrpc][ethdb][kv][remote_cursor]") {
+    // Set the call expectations:
+    // 1. AsyncReaderWriter<remote::Cursor, remote::Pair>::Write call to open cursor succeeds
+    Expectation open = EXPECT_CALL(reader_writer_, Write(
+            AllOf(Property(&remote::Cursor::op, Eq(remote::Op::OPEN)), Property(&remote::Cursor::bucketname, Eq("table1"))), _))
+        .WillOnce(test::write_success(grpc_context_));
+    // 2. AsyncReaderWriter<remote::Cursor, remote::Pair>::Write calls to seek next succeed: 1 for the first next, 2 for the
+    // second one read ahead in one round trip, 1 after the seek restarting the window, none for the third next
+    EXPECT_CALL(reader_writer_, Write(
+            AllOf(Property(&remote::Cursor::op, Eq(remote::Op::NEXT)), Property(&remote::Cursor::cursor, Eq(3))), _))
+        .Times(4)
+        .After(open)
+        .WillRepeatedly(test::write_success(grpc_context_));
+    EXPECT_CALL(reader_writer_, Write(
+            AllOf(Property(&remote::Cursor::op, Eq(remote::Op::SEEK)), Property(&remote::Cursor::cursor, Eq(3))), _))
+        .After(open)
+        .WillOnce(test::write_success(grpc_context_));
+    // 3. AsyncReaderWriter<remote::Cursor, remote::Pair>::Read calls succeed, one per write
+    remote::Pair open_pair;
+    open_pair.set_cursorid(3);
+    remote::Pair next_pair1;
+    next_pair1.set_k("k1");
+    remote::Pair next_pair2;
+    next_pair2.set_k("k2");
+    remote::Pair next_pair3;
+    next_pair3.set_k("k3");
+    remote::Pair seek_pair;
+    seek_pair.set_k("k1");
+    EXPECT_CALL(reader_writer_, Read)
+        .WillOnce(test::read_success_with(grpc_context_, open_pair))
+        .WillOnce(test::read_success_with(grpc_context_, next_pair1))
+        .WillOnce(test::read_success_with(grpc_context_, next_pair2))
+        .WillOnce(test::read_success_with(grpc_context_, next_pair3))
+        .WillOnce(test::read_success_with(grpc_context_, seek_pair))
+        .WillOnce(test::read_success_with(grpc_context_, next_pair2));
+
+    // Execute the test preconditions: open a new cursor on specified table
+    REQUIRE_NOTHROW(spawn_and_wait(remote_cursor_.open_cursor("table1")));
+
+    // Execute the test: consecutive next calls return the records in order, seek drops the ones read ahead
+    CHECK(spawn_and_wait(remote_cursor_.next()).key == silkworm::bytes_of_string("k1"));
+    CHECK(spawn_and_wait(remote_cursor_.next()).key == silkworm::bytes_of_string("k2"));
+    CHECK(spawn_and_wait(remote_cursor_.next()).key == silkworm::bytes_of_string("k3"));
+    CHECK(spawn_and_wait(remote_cursor_.seek(silkworm::bytes_of_string("k1"))).key == silkworm::bytes_of_string("k1"));
+    CHECK(spawn_and_wait(remote_cursor_.next()).key == silkworm::bytes_of_string("k2"));
+}
+
 } // namespace silkrpc::ethdb::kv
@@ -21,13 +21,14 @@
 
 namespace silkrpc::ethdb::kv {
 
-RemoteDatabase::RemoteDatabase(agrpc::GrpcContext& grpc_context, std::shared_ptr<grpc::Channel> channel)
-    : grpc_context_(grpc_context), stub_{remote::KV::NewStub(channel)} {
+RemoteDatabase::RemoteDatabase(agrpc::GrpcContext& grpc_context, std::shared_ptr<grpc::Channel> channel, uint32_t max_cursor_read_ahead)
+    : grpc_context_(grpc_context), stub_{remote::KV::NewStub(channel)}, max_cursor_read_ahead_{max_cursor_read_ahead} {
     SILKRPC_TRACE << "RemoteDatabase::ctor " << this << "\n";
 }
 
-RemoteDatabase::RemoteDatabase(agrpc::GrpcContext& grpc_context, std::unique_ptr<remote::KV::StubInterface>&& stub)
-    : grpc_context_(grpc_context), stub_(std::move(stub)) {
+RemoteDatabase::RemoteDatabase(agrpc::GrpcContext& grpc_context, std::unique_ptr<remote::KV::StubInterface>&& stub,
+                               uint32_t max_cursor_read_ahead)
+    : grpc_context_(grpc_context), stub_(std::move(stub)), max_cursor_read_ahead_{max_cursor_read_ahead} {
     SILKRPC_TRACE << "RemoteDatabase::ctor " << this << "\n";
 }
 
@@ -37,7 +38,7 @@ RemoteDatabase::~RemoteDatabase() {
 
 boost::asio::awaitable<std::unique_ptr<Transaction>> RemoteDatabase::begin() {
     SILKRPC_TRACE << "RemoteDatabase::begin " << this << " start\n";
-    auto txn = std::make_unique<RemoteTransaction>(*stub_, grpc_context_);
+    auto txn = std::make_unique<RemoteTransaction>(*stub_, grpc_context_, max_cursor_read_ahead_);
     co_await txn->open();
     SILKRPC_TRACE << "RemoteDatabase::begin " << this << " txn: " << txn.get() << " end\n";
     co_return txn;
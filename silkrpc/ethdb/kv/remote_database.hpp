@@ -23,6 +23,7 @@
 #include <agrpc/grpc_context.hpp>
 #include <grpcpp/grpcpp.h>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/ethdb/database.hpp>
 #include <silkrpc/ethdb/transaction.hpp>
 #include <silkrpc/interfaces/remote/kv.grpc.pb.h>
@@ -31,8 +32,10 @@ namespace silkrpc::ethdb::kv {
 
 class RemoteDatabase: public Database {
 public:
-    RemoteDatabase(agrpc::GrpcContext& grpc_context, std::shared_ptr<grpc::Channel> channel);
-    RemoteDatabase(agrpc::GrpcContext& grpc_context, std::unique_ptr<remote::KV::StubInterface>&& stub);
+    RemoteDatabase(agrpc::GrpcContext& grpc_context, std::shared_ptr<grpc::Channel> channel,
+                   uint32_t max_cursor_read_ahead = kDefaultMaxCursorReadAhead);
+    RemoteDatabase(agrpc::GrpcContext& grpc_context, std::unique_ptr<remote::KV::StubInterface>&& stub,
+                   uint32_t max_cursor_read_ahead = kDefaultMaxCursorReadAhead);
 
     ~RemoteDatabase();
 
@@ -44,6 +47,7 @@ public:
 private:
     agrpc::GrpcContext& grpc_context_;
     std::unique_ptr<remote::KV::StubInterface> stub_;
+    uint32_t max_cursor_read_ahead_;
 };
 
 } // namespace silkrpc::ethdb::kv
@@ -26,8 +26,8 @@
 
 namespace silkrpc::ethdb::kv {
 
-RemoteTransaction::RemoteTransaction(remote::KV::StubInterface& stub, agrpc::GrpcContext& grpc_context)
-    : tx_rpc_{stub, grpc_context} {
+RemoteTransaction::RemoteTransaction(remote::KV::StubInterface& stub, agrpc::GrpcContext& grpc_context, uint32_t max_cursor_read_ahead)
+    : tx_rpc_{stub, grpc_context}, max_cursor_read_ahead_{max_cursor_read_ahead} {
 }
 
 RemoteTransaction::~RemoteTransaction() {
@@ -56,7 +56,7 @@ boost::asio::awaitable<std::shared_ptr<CursorDupSort>> RemoteTransaction::get_cu
     if (cursor_it != cursors_.end()) {
         co_return cursor_it->second;
     }
-    auto cursor = std::make_shared<RemoteCursor>(tx_rpc_);
+    auto cursor = std::make_shared<RemoteCursor>(tx_rpc_, max_cursor_read_ahead_);
     co_await cursor->open_cursor(table);
     cursors_[table] = cursor;
     co_return cursor;
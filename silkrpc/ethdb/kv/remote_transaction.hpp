@@ -28,6 +28,7 @@
 #include <boost/asio/awaitable.hpp>
 #include <grpcpp/grpcpp.h>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/ethdb/cursor.hpp>
 #include <silkrpc/ethdb/kv/remote_cursor.hpp>
@@ -38,7 +39,8 @@ namespace silkrpc::ethdb::kv {
 
 class RemoteTransaction : public Transaction {
 public:
-    explicit RemoteTransaction(remote::KV::StubInterface& stub, agrpc::GrpcContext& grpc_context);
+    explicit RemoteTransaction(remote::KV::StubInterface& stub, agrpc::GrpcContext& grpc_context,
+                               uint32_t max_cursor_read_ahead = kDefaultMaxCursorReadAhead);
 
     ~RemoteTransaction();
 
@@ -56,6 +58,7 @@ private:
     boost::asio::awaitable<std::shared_ptr<CursorDupSort>> get_cursor(const std::string& table);
 
     TxRpc tx_rpc_;
+    uint32_t max_cursor_read_ahead_;
     std::map<std::string, std::shared_ptr<CursorDupSort>> cursors_;
     uint64_t tx_id_;
 };
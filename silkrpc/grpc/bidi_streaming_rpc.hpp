@@ -115,6 +115,51 @@ private:
         using ReadNext::operator();
     };
 
+    struct Write {
+        BidiStreamingRpc& self_;
+        const Request& request;
+
+        template<typename Op>
+        void operator()(Op& op) {
+            SILKRPC_TRACE << "BidiStreamingRpc::Write::initiate " << this << "\n";
+            if (self_.reader_writer_) {
+                agrpc::write(self_.reader_writer_, request, boost::asio::bind_executor(self_.grpc_context_, std::move(op)));
+            } else {
+                op.complete(make_error_code(grpc::StatusCode::INTERNAL, "agrpc::write called before agrpc::request"));
+            }
+        }
+
+        template<typename Op>
+        void operator()(Op& op, bool ok) {
+            SILKRPC_TRACE << "BidiStreamingRpc::Write::completed " << this << " ok=" << ok << "\n";
+            if (ok) {
+                op.complete({});
+            } else {
+                self_.finish(std::move(op));
+            }
+        }
+
+        template<typename Op>
+        void operator()(Op& op, const boost::system::error_code& ec) {
+            op.complete(ec);
+        }
+    };
+
+    struct Read : ReadNext {
+        template<typename Op>
+        void operator()(Op& op) {
+            SILKRPC_TRACE << "BidiStreamingRpc::Read::initiate " << this << "\n";
+            if (this->self_.reader_writer_) {
+                agrpc::read(this->self_.reader_writer_, this->self_.reply_,
+                    boost::asio::bind_executor(this->self_.grpc_context_, boost::asio::experimental::append(std::move(op), detail::ReadDoneTag{})));
+            } else {
+                op.complete(make_error_code(grpc::StatusCode::INTERNAL, "agrpc::read called before agrpc::request"), this->self_.reply_);
+            }
+        }
+
+        using ReadNext::operator();
+    };
+
     struct WritesDoneAndFinish {
         BidiStreamingRpc& self_;
 
@@ -189,6 +234,18 @@ public:
         return boost::asio::async_compose<CompletionToken, void(boost::system::error_code, Reply&)>(WriteAndRead{*this, request}, token);
     }
 
+    //! Write one request without waiting for its reply: every write must be matched by one read, in order
+    template<typename CompletionToken = agrpc::DefaultCompletionToken>
+    auto write(const Request& request, CompletionToken&& token = {}) {
+        return boost::asio::async_compose<CompletionToken, void(boost::system::error_code)>(Write{*this, request}, token);
+    }
+
+    //! Read the reply to the oldest request written and not read yet
+    template<typename CompletionToken = agrpc::DefaultCompletionToken>
+    auto read(CompletionToken&& token = {}) {
+        return boost::asio::async_compose<CompletionToken, void(boost::system::error_code, Reply&)>(Read{*this}, token);
+    }
+
     template<typename CompletionToken = agrpc::DefaultCompletionToken>
     auto writes_done_and_finish(CompletionToken&& token = {}) {
         return boost::asio::async_compose<CompletionToken, void(boost::system::error_code)>(WritesDoneAndFinish{*this}, token);
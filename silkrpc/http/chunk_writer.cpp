@@ -0,0 +1,75 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "chunk_writer.hpp"
+
+#include <array>
+#include <sstream>
+#include <string>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc::http {
+
+static constexpr std::string_view kChunkedReplyHeaders{
+    "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\n\r\n"};
+static constexpr std::string_view kChunkSeparator{"\r\n"};
+static constexpr std::string_view kLastChunk{"0\r\n\r\n"};
+
+bool accepts_chunked_reply(int http_version_major, int http_version_minor) {
+    // RFC 7230 3.3.1: chunked transfer encoding must not be sent to HTTP/1.0 clients
+    return http_version_major > 1 || (http_version_major == 1 && http_version_minor >= 1);
+}
+
+boost::asio::awaitable<void> ChunkWriter::write(std::string_view content) {
+    // An empty chunk would be taken as the last one
+    if (content.empty() || closed_) {
+        co_return;
+    }
+    co_await start();
+
+    std::stringstream chunk_size;
+    chunk_size << std::hex << content.size() << kChunkSeparator;
+    const auto chunk_header = chunk_size.str();
+    const std::array<boost::asio::const_buffer, 3> buffers{
+        boost::asio::buffer(chunk_header), boost::asio::buffer(content), boost::asio::buffer(kChunkSeparator)};
+    const auto bytes_transferred = co_await boost::asio::async_write(socket_, buffers, boost::asio::use_awaitable);
+    SILKRPC_TRACE << "ChunkWriter::write bytes_transferred: " << bytes_transferred << "\n";
+}
+
+boost::asio::awaitable<void> ChunkWriter::close() {
+    if (closed_) {
+        co_return;
+    }
+    co_await start();
+    co_await boost::asio::async_write(socket_, boost::asio::buffer(kLastChunk), boost::asio::use_awaitable);
+    closed_ = true;
+    SILKRPC_DEBUG << "ChunkWriter::close socket " << &socket_ << " reply completed\n";
+}
+
+boost::asio::awaitable<void> ChunkWriter::start() {
+    if (started_) {
+        co_return;
+    }
+    started_ = true;
+    co_await boost::asio::async_write(socket_, boost::asio::buffer(kChunkedReplyHeaders), boost::asio::use_awaitable);
+}
+
+} // namespace silkrpc::http
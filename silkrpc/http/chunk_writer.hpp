@@ -0,0 +1,66 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef SILKRPC_HTTP_CHUNK_WRITER_HPP_
+#define SILKRPC_HTTP_CHUNK_WRITER_HPP_
+
+#include <string_view>
+
+#include <silkrpc/config.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <silkrpc/common/writer.hpp>
+
+namespace silkrpc::http {
+
+//! Tell if a client speaking the given HTTP version accepts chunked transfer encoding, i.e. HTTP/1.1 or later
+bool accepts_chunked_reply(int http_version_major, int http_version_minor);
+
+//! Writer sending a successful HTTP reply with chunked transfer encoding: the headers go out with the first content
+//! and each write is one chunk, so the reply can be sent before it is complete
+class ChunkWriter : public Writer {
+public:
+    explicit ChunkWriter(boost::asio::ip::tcp::socket& socket) : socket_(socket) {}
+
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+    boost::asio::awaitable<void> write(std::string_view content) override;
+
+    boost::asio::awaitable<void> close() override;
+
+    //! Tell if anything has been sent on the socket
+    bool started() const { return started_; }
+
+    //! Tell if the reply has been sent completely
+    bool closed() const { return closed_; }
+
+    //! Tell if the reply has been sent only partially
+    bool interrupted() const { return started_ && !closed_; }
+
+private:
+    boost::asio::awaitable<void> start();
+
+    boost::asio::ip::tcp::socket& socket_;
+    bool started_{false};
+    bool closed_{false};
+};
+
+} // namespace silkrpc::http
+
+#endif // SILKRPC_HTTP_CHUNK_WRITER_HPP_
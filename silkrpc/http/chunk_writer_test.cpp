@@ -0,0 +1,109 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "chunk_writer.hpp"
+
+#include <string>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+
+namespace silkrpc::http {
+
+static constexpr const char* kChunkedHeaders{"HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\n\r\n"};
+
+// Server and client ends of a loopback TCP connection
+struct ChunkWriterTest {
+    boost::asio::io_context io_context;
+    boost::asio::ip::tcp::socket server{io_context};
+    boost::asio::ip::tcp::socket client{io_context};
+
+    ChunkWriterTest() {
+        boost::asio::ip::tcp::acceptor acceptor{io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+        client.connect(acceptor.local_endpoint());
+        acceptor.accept(server);
+    }
+
+    void run(boost::asio::awaitable<void> awaitable) {
+        auto result{boost::asio::co_spawn(io_context, std::move(awaitable), boost::asio::use_future)};
+        io_context.run();
+        io_context.restart();
+        result.get();
+    }
+
+    // Everything received by the client once the server end is closed
+    std::string received() {
+        server.close();
+        std::string content;
+        boost::system::error_code ec;
+        boost::asio::read(client, boost::asio::dynamic_buffer(content), ec);
+        CHECK(ec == boost::asio::error::eof);
+        return content;
+    }
+};
+
+TEST_CASE("accepts_chunked_reply", "[silkrpc][http][chunk_writer]") {
+    CHECK(!accepts_chunked_reply(0, 9));
+    CHECK(!accepts_chunked_reply(1, 0));
+    CHECK(accepts_chunked_reply(1, 1));
+    CHECK(accepts_chunked_reply(2, 0));
+}
+
+TEST_CASE_METHOD(ChunkWriterTest, "ChunkWriter::write", "[silkrpc][http][chunk_writer]") {
+    ChunkWriter writer{server};
+
+    SECTION("headers go out with the first chunk") {
+        run(writer.write("{\"result\":["));
+        run(writer.write("1]}"));
+        CHECK(writer.started());
+        CHECK(!writer.closed());
+        CHECK(writer.interrupted());
+        CHECK(received() == std::string{kChunkedHeaders} + "b\r\n{\"result\":[\r\n3\r\n1]}\r\n");
+    }
+
+    SECTION("empty content is not sent") {
+        run(writer.write(""));
+        CHECK(!writer.started());
+        CHECK(!writer.interrupted());
+        CHECK(received().empty());
+    }
+}
+
+TEST_CASE_METHOD(ChunkWriterTest, "ChunkWriter::close", "[silkrpc][http][chunk_writer]") {
+    ChunkWriter writer{server};
+
+    SECTION("last chunk ends the reply") {
+        run(writer.write("{}"));
+        run(writer.close());
+        CHECK(writer.closed());
+        CHECK(!writer.interrupted());
+        run(writer.write("ignored"));
+        run(writer.close());
+        CHECK(received() == std::string{kChunkedHeaders} + "2\r\n{}\r\n0\r\n\r\n");
+    }
+
+    SECTION("reply without content") {
+        run(writer.close());
+        CHECK(writer.started());
+        CHECK(writer.closed());
+        CHECK(received() == std::string{kChunkedHeaders} + "0\r\n\r\n");
+    }
+}
+
+} // namespace silkrpc::http
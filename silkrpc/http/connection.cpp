@@ -38,8 +38,9 @@
 
 namespace silkrpc::http {
 
-Connection::Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table)
-: socket_{*context.io_context()}, request_handler_{context, workers, handler_table} {
+Connection::Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table,
+                       std::size_t max_batch_size)
+: socket_{*context.io_context()}, request_handler_{context, workers, handler_table, max_batch_size} {
     request_.content.reserve(kRequestContentInitialCapacity);
     request_.headers.reserve(kRequestHeadersInitialCapacity);
     request_.method.reserve(kRequestMethodInitialCapacity);
@@ -66,8 +67,13 @@ boost::asio::awaitable<void> Connection::do_read() {
         RequestParser::ResultType result = request_parser_.parse(request_, buffer_.data(), buffer_.data() + bytes_read);
 
         if (result == RequestParser::good) {
-            co_await request_handler_.handle_request(request_, reply_);
-            co_await do_write();
+            // Responses built incrementally are sent as they go with chunked transfer encoding, the others at once
+            ChunkWriter chunk_writer{socket_};
+            const bool chunked = accepts_chunked_reply(request_.http_version_major, request_.http_version_minor);
+            co_await request_handler_.handle_request(request_, reply_, chunked ? &chunk_writer : nullptr);
+            if (!co_await complete_reply(socket_, chunk_writer, reply_)) {
+                co_return;
+            }
             clean();
         } else if (result == RequestParser::bad) {
             reply_ = Reply::stock_reply(Reply::bad_request);
@@ -108,6 +114,20 @@ boost::asio::awaitable<void> Connection::do_write() {
     }
 }
 
+boost::asio::awaitable<bool> complete_reply(boost::asio::ip::tcp::socket& socket, const ChunkWriter& chunk_writer, Reply& reply) {
+    if (chunk_writer.interrupted()) {
+        SILKRPC_ERROR << "complete_reply chunked reply interrupted, closing socket " << &socket << "\n";
+        socket.close();
+        co_return false;
+    }
+    if (!chunk_writer.started()) {
+        SILKRPC_DEBUG << "complete_reply reply: " << reply.content << "\n" << std::flush;
+        const auto bytes_transferred = co_await boost::asio::async_write(socket, reply.to_buffers(), boost::asio::use_awaitable);
+        SILKRPC_TRACE << "complete_reply bytes_transferred: " << bytes_transferred << "\n" << std::flush;
+    }
+    co_return true;
+}
+
 void Connection::clean() {
     request_.reset();
     request_parser_.reset();
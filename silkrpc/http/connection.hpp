@@ -34,6 +34,7 @@
 #include <silkrpc/commands/rpc_api_table.hpp>
 #include <silkrpc/common/constants.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
+#include <silkrpc/http/chunk_writer.hpp>
 #include <silkrpc/http/reply.hpp>
 #include <silkrpc/http/request.hpp>
 #include <silkrpc/http/request_handler.hpp>
@@ -41,6 +42,11 @@
 
 namespace silkrpc::http {
 
+/// Complete the reply to a request handled with chunk_writer: the reply is sent at once unless it has been streamed.
+/// Return false if the streamed reply has been interrupted, the socket is then closed since the client could not tell
+/// where the next reply starts.
+boost::asio::awaitable<bool> complete_reply(boost::asio::ip::tcp::socket& socket, const ChunkWriter& chunk_writer, Reply& reply);
+
 /// Represents a single connection from a client.
 class Connection {
 public:
@@ -48,7 +54,8 @@ public:
     Connection& operator=(const Connection&) = delete;
 
     /// Construct a connection running within the given execution context.
-    Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table);
+    Connection(Context& context, boost::asio::thread_pool& workers, commands::RpcApiTable& handler_table,
+               std::size_t max_batch_size = kDefaultMaxBatchSize);
 
     ~Connection();
 
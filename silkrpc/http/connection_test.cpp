@@ -16,7 +16,13 @@
 
 #include "connection.hpp"
 
+#include <string>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/read.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
 #include <catch2/catch.hpp>
 #include <grpcpp/grpcpp.h>
 
@@ -46,4 +52,56 @@ TEST_CASE("connection creation", "[silkrpc][http][connection]") {
     }
 }
 
+TEST_CASE("complete_reply", "[silkrpc][http][connection]") {
+    SILKRPC_LOG_VERBOSITY(LogLevel::None);
+
+    boost::asio::io_context io_context;
+    boost::asio::ip::tcp::socket server{io_context};
+    boost::asio::ip::tcp::socket client{io_context};
+    boost::asio::ip::tcp::acceptor acceptor{io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+
+    const auto run = [&](auto awaitable) {
+        auto result{boost::asio::co_spawn(io_context, std::move(awaitable), boost::asio::use_future)};
+        io_context.run();
+        io_context.restart();
+        return result.get();
+    };
+    const auto received = [&]() {
+        std::string content;
+        boost::system::error_code ec;
+        boost::asio::read(client, boost::asio::dynamic_buffer(content), ec);
+        CHECK(ec == boost::asio::error::eof);
+        return content;
+    };
+
+    ChunkWriter chunk_writer{server};
+    Reply reply{Reply::ok, {{"Content-Length", "2"}}, "{}"};
+
+    SECTION("buffered reply") {
+        CHECK(run(complete_reply(server, chunk_writer, reply)));
+        CHECK(server.is_open());
+        server.close();
+        CHECK(received() == "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}");
+    }
+
+    SECTION("streamed reply") {
+        run(chunk_writer.write("{}"));
+        run(chunk_writer.close());
+        CHECK(run(complete_reply(server, chunk_writer, reply)));
+        CHECK(server.is_open());
+        server.close();
+        CHECK(received().ends_with("2\r\n{}\r\n0\r\n\r\n"));
+    }
+
+    SECTION("interrupted reply closes the socket") {
+        run(chunk_writer.write("{\"result\":["));
+        CHECK(!run(complete_reply(server, chunk_writer, reply)));
+        CHECK(!server.is_open());
+        // The client sees the transfer end without the last chunk
+        CHECK(received().ends_with("b\r\n{\"result\":[\r\n"));
+    }
+}
+
 } // namespace silkrpc::http
@@ -22,23 +22,34 @@
 
 #include "request_handler.hpp"
 
+#include <chrono>
 #include <iostream>
 #include <utility>
+#include <vector>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/experimental/as_tuple.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <nlohmann/json.hpp>
 
 #include <silkrpc/common/clock_time.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/http/header.hpp>
+#include <silkrpc/json/stream.hpp>
 
 namespace silkrpc::http {
 
-boost::asio::awaitable<void> RequestHandler::handle_request(const http::Request& request, http::Reply& reply) {
+static std::string dump_reply(const nlohmann::json& reply_json) {
+    return reply_json.dump(
+        /*indent=*/-1, /*indent_char=*/' ', /*ensure_ascii=*/false, nlohmann::json::error_handler_t::replace) + "\n";
+}
+
+boost::asio::awaitable<void> RequestHandler::handle_request(const http::Request& request, http::Reply& reply, Writer* stream_writer) {
     SILKRPC_DEBUG << "handle_request content: " << request.content << "\n";
     auto start = clock_time::now();
 
-    nlohmann::json request_id{};
-
     try {
         if (request.content.empty()) {
             reply.content = "";
@@ -55,52 +66,130 @@ boost::asio::awaitable<void> RequestHandler::handle_request(const http::Request&
         }
 
         const auto request_json = nlohmann::json::parse(request.content);
-        request_id = request_json["id"];
-        if (!request_json.contains("method")) {
-            reply.content = make_json_error(request_id, -32600, "method missing").dump() + "\n";
-            reply.status = http::Reply::bad_request;
-            reply.headers.reserve(2);
-            reply.headers.emplace_back(http::Header{"Content-Length", std::to_string(reply.content.size())});
-            reply.headers.emplace_back(http::Header{"Content-Type", "application/json"});
+        if (request_json.is_array()) {
+            const MessageHandler handle_message = [this](const nlohmann::json& message_json, nlohmann::json& response_json) {
+                return handle_request_message(message_json, response_json);
+            };
+            co_await handle_batch(request_json, max_batch_size_, handle_message, reply);
+        } else if (stream_writer != nullptr && co_await handle_request_stream(request_json, *stream_writer)) {
             SILKRPC_INFO << "handle_request t=" << clock_time::since(start) << "ns\n";
             co_return;
+        } else {
+            nlohmann::json reply_json;
+            reply.status = co_await handle_request_message(request_json, reply_json);
+            reply.content = dump_reply(reply_json);
+        }
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << "\n";
+        reply.content = make_json_error(nullptr, 100, e.what()).dump() + "\n";
+        reply.status = http::Reply::internal_server_error;
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception\n";
+        reply.content = make_json_error(nullptr, 100, "unexpected exception").dump() + "\n";
+        reply.status = http::Reply::internal_server_error;
+    }
+
+    reply.headers.reserve(2);
+    reply.headers.emplace_back(http::Header{"Content-Length", std::to_string(reply.content.size())});
+    reply.headers.emplace_back(http::Header{"Content-Type", "application/json"});
+
+    SILKRPC_INFO << "handle_request t=" << clock_time::since(start) << "ns\n";
+    co_return;
+}
+
+boost::asio::awaitable<http::Reply::StatusType> RequestHandler::handle_request_message(const nlohmann::json& request_json, nlohmann::json& reply_json) {
+    nlohmann::json request_id{};
+
+    try {
+        if (!request_json.is_object()) {
+            reply_json = make_json_error(request_id, -32600, "invalid request");
+            co_return http::Reply::bad_request;
+        }
+
+        request_id = request_json.value("id", nlohmann::json{});
+        if (!request_json.contains("method")) {
+            reply_json = make_json_error(request_id, -32600, "method missing");
+            co_return http::Reply::bad_request;
         }
 
         const auto method = request_json["method"].get<std::string>();
         const auto handle_method_opt = rpc_api_table_.find_handler(method);
         if (!handle_method_opt) {
-            reply.content = make_json_error(request_id, -32601, "the method " + method + " does not exist/is not available").dump() + "\n";
-            reply.status = http::Reply::not_implemented;
-            reply.headers.reserve(2);
-            reply.headers.emplace_back(http::Header{"Content-Length", std::to_string(reply.content.size())});
-            reply.headers.emplace_back(http::Header{"Content-Type", "application/json"});
-            SILKRPC_INFO << "handle_request t=" << clock_time::since(start) << "ns\n";
-            co_return;
+            reply_json = make_json_error(request_id, -32601, "the method " + method + " does not exist/is not available");
+            co_return http::Reply::not_implemented;
         }
         const auto handle_method = handle_method_opt.value();
 
-        nlohmann::json reply_json;
         co_await (rpc_api_.*handle_method)(request_json, reply_json);
-
-        reply.content = reply_json.dump(
-            /*indent=*/-1, /*indent_char=*/' ', /*ensure_ascii=*/false, nlohmann::json::error_handler_t::replace) + "\n";
-        reply.status = http::Reply::ok;
+        co_return http::Reply::ok;
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << "\n";
-        reply.content = make_json_error(request_id, 100, e.what()).dump() + "\n";
-        reply.status = http::Reply::internal_server_error;
+        reply_json = make_json_error(request_id, 100, e.what());
     } catch (...) {
         SILKRPC_ERROR << "unexpected exception\n";
-        reply.content = make_json_error(request_id, 100, "unexpected exception").dump() + "\n";
-        reply.status = http::Reply::internal_server_error;
+        reply_json = make_json_error(request_id, 100, "unexpected exception");
     }
+    co_return http::Reply::internal_server_error;
+}
 
-    reply.headers.reserve(2);
-    reply.headers.emplace_back(http::Header{"Content-Length", std::to_string(reply.content.size())});
-    reply.headers.emplace_back(http::Header{"Content-Type", "application/json"});
+boost::asio::awaitable<bool> RequestHandler::handle_request_stream(const nlohmann::json& request_json, Writer& writer) {
+    if (!request_json.is_object() || !request_json.contains("method") || !request_json["method"].is_string()) {
+        co_return false;
+    }
+    const auto handle_stream_opt = rpc_api_table_.find_stream_handler(request_json["method"].get<std::string>());
+    if (!handle_stream_opt) {
+        co_return false;
+    }
+    const auto handle_stream = handle_stream_opt.value();
+
+    // The stream handler reports its own errors inside the response. If it throws, part of the response may already
+    // be sent: the stream is left open, so the connection drops the interrupted reply instead of terminating it.
+    json::Stream stream{writer};
+    co_await (rpc_api_.*handle_stream)(request_json, stream);
+    co_await stream.close();
+    co_return true;
+}
 
-    SILKRPC_INFO << "handle_request t=" << clock_time::since(start) << "ns\n";
-    co_return;
+boost::asio::awaitable<void> handle_batch(const nlohmann::json& batch_json, std::size_t max_batch_size,
+                                          const MessageHandler& handle_message, http::Reply& reply) {
+    if (batch_json.empty() || batch_json.size() > max_batch_size) {
+        const auto message = batch_json.empty() ? std::string{"empty batch"} :
+            "batch size " + std::to_string(batch_json.size()) + " exceeds limit " + std::to_string(max_batch_size);
+        reply.content = make_json_error(nullptr, -32600, message).dump() + "\n";
+        reply.status = http::Reply::bad_request;
+        co_return;
+    }
+
+    // Every request runs as its own coroutine on the executor of this connection, so those waiting on the database
+    // or the workers overlap. The timer is only used to be woken up when the last one completes.
+    auto executor = co_await boost::asio::this_coro::executor;
+    boost::asio::steady_timer batch_done{executor, std::chrono::steady_clock::time_point::max()};
+    std::vector<nlohmann::json> replies(batch_json.size());
+    std::size_t pending{batch_json.size()};
+    for (std::size_t i{0}; i < batch_json.size(); ++i) {
+        boost::asio::co_spawn(executor, handle_message(batch_json[i], replies[i]),
+            [&](std::exception_ptr, http::Reply::StatusType) {
+                if (--pending == 0) batch_done.cancel();
+            });
+    }
+    if (pending > 0) {
+        co_await batch_done.async_wait(boost::asio::experimental::as_tuple(boost::asio::use_awaitable));
+    }
+
+    // Notifications, i.e. requests without id, get no response
+    auto reply_json = nlohmann::json::array();
+    for (std::size_t i{0}; i < batch_json.size(); ++i) {
+        if (batch_json[i].is_object() && !batch_json[i].contains("id")) continue;
+        reply_json.push_back(std::move(replies[i]));
+    }
+
+    if (reply_json.empty()) {
+        reply.content = "";
+        reply.status = http::Reply::no_content;
+        co_return;
+    }
+    reply.content = dump_reply(reply_json);
+    reply.status = http::Reply::ok;
 }
 
 } // namespace silkrpc::http
@@ -17,6 +17,7 @@
 #ifndef SILKRPC_HTTP_REQUEST_HANDLER_HPP_
 #define SILKRPC_HTTP_REQUEST_HANDLER_HPP_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -25,7 +26,10 @@
 
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <nlohmann/json.hpp>
 
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/writer.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/commands/rpc_api.hpp>
 #include <silkrpc/commands/rpc_api_table.hpp>
@@ -34,19 +38,39 @@
 
 namespace silkrpc::http {
 
+//! Handle one JSON-RPC request object, filling its response and returning the HTTP status it would have alone.
+using MessageHandler = std::function<boost::asio::awaitable<http::Reply::StatusType>(const nlohmann::json&, nlohmann::json&)>;
+
+//! Handle a JSON-RPC batch, running its requests concurrently with handle_message and replying with their responses in
+//! order. Notifications get no response, a batch that is empty or has more than max_batch_size requests is rejected.
+boost::asio::awaitable<void> handle_batch(const nlohmann::json& batch_json, std::size_t max_batch_size,
+                                          const MessageHandler& handle_message, http::Reply& reply);
+
 class RequestHandler {
 public:
-    RequestHandler(Context& context, boost::asio::thread_pool& workers, const commands::RpcApiTable& rpc_api_table)
-        : rpc_api_{context, workers}, rpc_api_table_(rpc_api_table) {}
+    RequestHandler(Context& context, boost::asio::thread_pool& workers, const commands::RpcApiTable& rpc_api_table,
+                   std::size_t max_batch_size = kDefaultMaxBatchSize)
+        : rpc_api_{context, workers}, rpc_api_table_(rpc_api_table), max_batch_size_{max_batch_size} {}
 
     RequestHandler(const RequestHandler&) = delete;
     RequestHandler& operator=(const RequestHandler&) = delete;
 
-    boost::asio::awaitable<void> handle_request(const http::Request& request, http::Reply& reply);
+    //! Handle the request filling the reply or, for a single request to a method with a stream handler when
+    //! stream_writer is given, writing the response into stream_writer leaving the reply untouched
+    boost::asio::awaitable<void> handle_request(const http::Request& request, http::Reply& reply, Writer* stream_writer = nullptr);
 
 private:
+    //! Handle one JSON-RPC request object, filling its response and returning the HTTP status it would have alone.
+    boost::asio::awaitable<http::Reply::StatusType> handle_request_message(const nlohmann::json& request_json, nlohmann::json& reply_json);
+
+    //! Handle one JSON-RPC request object writing its response into the writer, if its method has a stream handler.
+    boost::asio::awaitable<bool> handle_request_stream(const nlohmann::json& request_json, Writer& writer);
+
     commands::RpcApi rpc_api_;
     const commands::RpcApiTable& rpc_api_table_;
+
+    //! The maximum number of requests accepted in one batch
+    std::size_t max_batch_size_;
 };
 
 } // namespace silkrpc::http
@@ -16,14 +16,21 @@
 
 #include "request_handler.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <thread>
 #include <vector>
 
 #include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/use_future.hpp>
 #include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
 #include <silkworm/common/util.hpp>
 
 #include <silkrpc/common/log.hpp>
@@ -31,6 +38,7 @@
 #include <silkrpc/http/request.hpp>
 #include <silkrpc/http/reply.hpp>
 #include <silkrpc/http/header.hpp>
+#include <silkrpc/json/types.hpp>
 
 namespace silkrpc::http {
 
@@ -181,5 +189,87 @@ TEST_CASE("check handle_request method return failed", "[silkrpc][handle_request
 */
 }
 
+// Handler replying with the id of the request after a delay decreasing with it, so later requests complete first
+static MessageHandler make_echo_handler(std::size_t& in_flight, std::size_t& max_in_flight) {
+    return [in_flight = &in_flight, max_in_flight = &max_in_flight](const nlohmann::json& request_json, nlohmann::json& reply_json) -> boost::asio::awaitable<http::Reply::StatusType> {
+        const auto id = request_json.value("id", 0);
+        *max_in_flight = std::max(*max_in_flight, ++*in_flight);
+        boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor, std::chrono::milliseconds{10 - id}};
+        co_await timer.async_wait(boost::asio::use_awaitable);
+        --*in_flight;
+        reply_json = {{"jsonrpc", "2.0"}, {"id", id}, {"result", id}};
+        co_return http::Reply::ok;
+    };
+}
+
+static http::Reply run_batch(const nlohmann::json& batch_json, std::size_t max_batch_size, const MessageHandler& handler) {
+    boost::asio::io_context io_context;
+    http::Reply reply{};
+    auto result{boost::asio::co_spawn(io_context, handle_batch(batch_json, max_batch_size, handler, reply), boost::asio::use_future)};
+    io_context.run();
+    result.get();
+    return reply;
+}
+
+TEST_CASE("check handle_batch", "[silkrpc][handle_request]") {
+    std::size_t in_flight{0};
+    std::size_t max_in_flight{0};
+    const auto handler = make_echo_handler(in_flight, max_in_flight);
+
+    SECTION("empty batch") {
+        const auto reply = run_batch(nlohmann::json::array(), 10, handler);
+        CHECK(reply.content == "{\"error\":{\"code\":-32600,\"message\":\"empty batch\"},\"id\":null,\"jsonrpc\":\"2.0\"}\n");
+        CHECK(reply.status == http::Reply::bad_request);
+        CHECK(max_in_flight == 0);
+    }
+
+    SECTION("batch too large") {
+        const auto batch_json = R"([{"jsonrpc":"2.0","id":1,"method":"eth_AAA"},{"jsonrpc":"2.0","id":2,"method":"eth_AAA"}])"_json;
+        const auto reply = run_batch(batch_json, 1, handler);
+        CHECK(reply.content == "{\"error\":{\"code\":-32600,\"message\":\"batch size 2 exceeds limit 1\"},\"id\":null,\"jsonrpc\":\"2.0\"}\n");
+        CHECK(reply.status == http::Reply::bad_request);
+        CHECK(max_in_flight == 0);
+    }
+
+    SECTION("responses in request order") {
+        const auto batch_json = R"([
+            {"jsonrpc":"2.0","id":1,"method":"eth_AAA"},
+            {"jsonrpc":"2.0","method":"eth_AAA"},
+            {"jsonrpc":"2.0","id":3,"method":"eth_AAA"}
+        ])"_json;
+        const auto reply = run_batch(batch_json, 10, handler);
+        // The notification gets no response, the requests run concurrently
+        CHECK(reply.content == "[{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":1},{\"id\":3,\"jsonrpc\":\"2.0\",\"result\":3}]\n");
+        CHECK(reply.status == http::Reply::ok);
+        CHECK(max_in_flight == 3);
+        CHECK(in_flight == 0);
+    }
+
+    SECTION("only notifications") {
+        const auto batch_json = R"([{"jsonrpc":"2.0","method":"eth_AAA"},{"jsonrpc":"2.0","method":"eth_BBB"}])"_json;
+        const auto reply = run_batch(batch_json, 10, handler);
+        CHECK(reply.content.empty());
+        CHECK(reply.status == http::Reply::no_content);
+        CHECK(max_in_flight == 2);
+    }
+
+    SECTION("request errors are reported per request") {
+        const MessageHandler failing_handler = [](const nlohmann::json& request_json, nlohmann::json& reply_json) -> boost::asio::awaitable<http::Reply::StatusType> {
+            const auto id = request_json.value("id", 0);
+            if (id == 1) {
+                reply_json = make_json_error(id, -32601, "the method eth_AAA does not exist/is not available");
+                co_return http::Reply::not_implemented;
+            }
+            reply_json = {{"jsonrpc", "2.0"}, {"id", id}, {"result", id}};
+            co_return http::Reply::ok;
+        };
+        const auto batch_json = R"([{"jsonrpc":"2.0","id":1,"method":"eth_AAA"},{"jsonrpc":"2.0","id":2,"method":"eth_BBB"}])"_json;
+        const auto reply = run_batch(batch_json, 10, failing_handler);
+        CHECK(reply.content == "[{\"error\":{\"code\":-32601,\"message\":\"the method eth_AAA does not exist/is not available\"},\"id\":1,\"jsonrpc\":\"2.0\"},"
+                               "{\"id\":2,\"jsonrpc\":\"2.0\",\"result\":2}]\n");
+        CHECK(reply.status == http::Reply::ok);
+    }
+}
+
 } // namespace silkrpc::http
 
@@ -49,8 +49,10 @@ std::tuple<std::string, std::string> Server::parse_endpoint(const std::string& t
     return {host, port};
 }
 
-Server::Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers)
-: context_(context), workers_(workers), acceptor_{*context.io_context()}, handler_table_{api_spec} {
+Server::Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers,
+               std::size_t max_batch_size)
+: context_(context), workers_(workers), acceptor_{*context.io_context()}, handler_table_{api_spec}, max_batch_size_{max_batch_size},
+  connection_contexts_{&context} {
     const auto [host, port] = parse_endpoint(end_point);
 
     // Open the acceptor with the option to reuse the address (i.e. SO_REUSEADDR).
@@ -62,6 +64,21 @@ Server::Server(const std::string& end_point, const std::string& api_spec, Contex
     acceptor_.bind(endpoint);
 }
 
+Server::Server(const std::string& end_point, const std::string& api_spec, ContextPool& context_pool, boost::asio::thread_pool& workers,
+               std::size_t max_batch_size)
+: Server{end_point, api_spec, context_pool.context(0), workers, max_batch_size} {
+    for (std::size_t i{1}; i < context_pool.size(); ++i) {
+        connection_contexts_.push_back(&context_pool.context(i));
+    }
+}
+
+Context& Server::next_connection_context() {
+    // Only called by run, so there is no concurrent access to the index
+    auto& context = *connection_contexts_[next_connection_index_];
+    next_connection_index_ = (next_connection_index_ + 1) % connection_contexts_.size();
+    return context;
+}
+
 void Server::start() {
     boost::asio::co_spawn(acceptor_.get_executor(), run(), [&](std::exception_ptr eptr) {
         if (eptr) std::rethrow_exception(eptr);
@@ -73,14 +90,16 @@ boost::asio::awaitable<void> Server::run() {
 
     try {
         while (acceptor_.is_open()) {
-            auto io_context = context_.io_context();
+            // The socket of the connection belongs to the context running it, the acceptor stays on its own
+            auto& connection_context = next_connection_context();
+            auto io_context = connection_context.io_context();
 
             SILKRPC_DEBUG << "Server::run accepting using io_context " << io_context << "...\n" << std::flush;
 
             std::shared_ptr<Connection> new_connection;
 
             try {
-                new_connection = std::make_shared<Connection>(context_, workers_, handler_table_);
+                new_connection = std::make_shared<Connection>(connection_context, workers_, handler_table_, max_batch_size_);
                 co_await acceptor_.async_accept(new_connection->socket(), boost::asio::use_awaitable);
             } catch (const boost::system::system_error& se) {
                 if (se.code() == boost::asio::error::no_descriptors) {
@@ -33,6 +33,7 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/thread_pool.hpp>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/http/request_handler.hpp>
 
@@ -47,7 +48,12 @@ public:
     Server& operator=(const Server&) = delete;
 
     // Construct the server to listen on the specified local TCP end-point
-    explicit Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers);
+    explicit Server(const std::string& end_point, const std::string& api_spec, Context& context, boost::asio::thread_pool& workers,
+                    std::size_t max_batch_size = kDefaultMaxBatchSize);
+
+    // Construct the server to accept on the first context of the pool and to run each connection on every context in turn
+    explicit Server(const std::string& end_point, const std::string& api_spec, ContextPool& context_pool, boost::asio::thread_pool& workers,
+                    std::size_t max_batch_size = kDefaultMaxBatchSize);
 
     void start();
 
@@ -58,6 +64,9 @@ private:
 
     boost::asio::awaitable<void> run();
 
+    // The context to run the next accepted connection
+    Context& next_connection_context();
+
     // The repository of API request handlers
     commands::RpcApiTable handler_table_;
 
@@ -68,6 +77,13 @@ private:
     boost::asio::ip::tcp::acceptor acceptor_;
 
     boost::asio::thread_pool& workers_;
+
+    // The maximum number of requests accepted in one JSON-RPC batch
+    std::size_t max_batch_size_;
+
+    // The contexts running the accepted connections, used in turn
+    std::vector<Context*> connection_contexts_;
+    std::size_t next_connection_index_{0};
 };
 
 } // namespace silkrpc::http
@@ -0,0 +1,97 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "stream.hpp"
+
+#include <string>
+
+namespace silkrpc::json {
+
+void Stream::open_object() {
+    write_separator();
+    buffer_.push_back('{');
+    has_entries_.push_back(false);
+}
+
+void Stream::close_object() {
+    has_entries_.pop_back();
+    buffer_.push_back('}');
+}
+
+void Stream::open_array() {
+    write_separator();
+    buffer_.push_back('[');
+    has_entries_.push_back(false);
+}
+
+void Stream::close_array() {
+    has_entries_.pop_back();
+    buffer_.push_back(']');
+}
+
+void Stream::write_field(std::string_view name) {
+    write_separator();
+    buffer_.append(nlohmann::json(std::string{name}).dump());
+    buffer_.push_back(':');
+    after_field_name_ = true;
+}
+
+void Stream::write_field(std::string_view name, const nlohmann::json& value) {
+    write_field(name);
+    write_json(value);
+}
+
+void Stream::write_json(const nlohmann::json& value) {
+    write_separator();
+    buffer_.append(value.dump(/*indent=*/-1, /*indent_char=*/' ', /*ensure_ascii=*/false, nlohmann::json::error_handler_t::replace));
+}
+
+boost::asio::awaitable<void> Stream::flush() {
+    if (buffer_.empty()) {
+        co_return;
+    }
+    co_await writer_.write(buffer_);
+    buffer_.clear();
+    flushed_ = true;
+}
+
+boost::asio::awaitable<void> Stream::close() {
+    buffer_.push_back('\n');
+    co_await flush();
+    co_await writer_.close();
+}
+
+void Stream::reset() {
+    buffer_.clear();
+    has_entries_.clear();
+    after_field_name_ = false;
+}
+
+void Stream::write_separator() {
+    // The value of a field follows its name without any separator
+    if (after_field_name_) {
+        after_field_name_ = false;
+        return;
+    }
+    if (!has_entries_.empty()) {
+        if (has_entries_.back()) {
+            buffer_.push_back(',');
+        }
+        has_entries_.back() = true;
+    }
+}
+
+} // namespace silkrpc::json
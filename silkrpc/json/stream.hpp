@@ -0,0 +1,83 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef SILKRPC_JSON_STREAM_HPP_
+#define SILKRPC_JSON_STREAM_HPP_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <silkrpc/config.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkrpc/common/writer.hpp>
+
+namespace silkrpc::json {
+
+//! Incremental JSON serialization into a Writer: the document is built by opening and closing objects and arrays,
+//! the separators are handled here and the content buffered so far goes out on each flush
+class Stream {
+public:
+    explicit Stream(Writer& writer) : writer_(writer) {}
+
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+
+    void open_object();
+    void close_object();
+
+    void open_array();
+    void close_array();
+
+    //! Write the name of a field whose value comes next, e.g. an object or an array
+    void write_field(std::string_view name);
+    void write_field(std::string_view name, const nlohmann::json& value);
+
+    //! Write a whole value, e.g. an entry of the current array
+    void write_json(const nlohmann::json& value);
+
+    //! Send the buffered content to the writer
+    boost::asio::awaitable<void> flush();
+
+    //! Send the buffered content and close the writer
+    boost::asio::awaitable<void> close();
+
+    //! Whether any content has already been sent to the writer, after which it cannot be taken back
+    bool flushed() const { return flushed_; }
+
+    //! Drop all the content buffered so far, to be used only while nothing has been flushed
+    void reset();
+
+private:
+    void write_separator();
+
+    Writer& writer_;
+    std::string buffer_;
+
+    //! For each open object or array, whether it already contains any entry
+    std::vector<bool> has_entries_;
+
+    bool after_field_name_{false};
+
+    bool flushed_{false};
+};
+
+} // namespace silkrpc::json
+
+#endif // SILKRPC_JSON_STREAM_HPP_
@@ -0,0 +1,92 @@
+/*
+    Copyright 2022 The Silkrpc Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "stream.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+
+namespace silkrpc::json {
+
+TEST_CASE("write empty containers", "[silkrpc][json][stream]") {
+    boost::asio::thread_pool pool{1};
+    StringWriter writer;
+    Stream stream{writer};
+
+    stream.open_object();
+    stream.write_field("result");
+    stream.open_array();
+    stream.close_array();
+    stream.close_object();
+    boost::asio::co_spawn(pool, stream.close(), boost::asio::use_future).get();
+    CHECK(writer.content() == "{\"result\":[]}\n");
+}
+
+TEST_CASE("write response incrementally", "[silkrpc][json][stream]") {
+    boost::asio::thread_pool pool{1};
+    StringWriter writer;
+    Stream stream{writer};
+
+    stream.open_object();
+    stream.write_field("jsonrpc", "2.0");
+    stream.write_field("id", 1);
+    stream.write_field("result");
+    stream.open_array();
+    stream.write_json(nlohmann::json{{"a", 1}});
+    boost::asio::co_spawn(pool, stream.flush(), boost::asio::use_future).get();
+    CHECK(writer.content() == "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":[{\"a\":1}");
+
+    stream.write_json(nlohmann::json::array({1, 2}));
+    stream.open_object();
+    stream.close_object();
+    stream.close_array();
+    stream.close_object();
+    boost::asio::co_spawn(pool, stream.close(), boost::asio::use_future).get();
+    CHECK(writer.content() == "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":[{\"a\":1},[1,2],{}]}\n");
+    CHECK(nlohmann::json::parse(writer.content())["result"].size() == 3);
+}
+
+TEST_CASE("reset content not yet flushed", "[silkrpc][json][stream]") {
+    boost::asio::thread_pool pool{1};
+    StringWriter writer;
+    Stream stream{writer};
+
+    stream.open_object();
+    stream.write_field("result");
+    stream.open_array();
+    stream.write_json(1);
+    CHECK(!stream.flushed());
+
+    stream.reset();
+    stream.write_json(nlohmann::json{{"error", 1}});
+    boost::asio::co_spawn(pool, stream.close(), boost::asio::use_future).get();
+    CHECK(stream.flushed());
+    CHECK(writer.content() == "{\"error\":1}\n");
+}
+
+TEST_CASE("empty flush sends nothing", "[silkrpc][json][stream]") {
+    boost::asio::thread_pool pool{1};
+    StringWriter writer;
+    Stream stream{writer};
+
+    boost::asio::co_spawn(pool, stream.flush(), boost::asio::use_future).get();
+    CHECK(!stream.flushed());
+    CHECK(writer.content().empty());
+}
+
+} // namespace silkrpc::json
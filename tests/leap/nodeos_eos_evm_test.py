@@ -119,7 +119,7 @@ def interact_with_storage_contract(dest, nonce):
         retValue = prodNode.pushMessage(evmAcc.name, "pushtx", json.dumps(actData), '-p {0}'.format(minerAcc.name))
         assert retValue[0], "pushtx to ETH contract failed."
         Utils.Print("\tBlock#", retValue[1]["processed"]["block_num"])
-        row0=prodNode.getTableRow(evmAcc.name, 3, "storage", 0)
+        row0=prodNode.getTableRow(evmAcc.name, 3, "storagev2", 0)
         Utils.Print("\tTable row:", row0)
         time.sleep(1)
 
@@ -529,7 +529,7 @@ try:
     Utils.Print("\tTest Account balance %s" % testAccActualAmount)
     if testAccActualAmount != expectedAmount:
         Utils.errorExit("Transfer verification failed. Excepted %s, actual: %s" % (expectedAmount, testAccActualAmount))
-    row3=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account", 3) # 3rd balance of this integration test
+    row3=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account2", 3) # 3rd balance of this integration test
     assert(row3["eth_address"] == "f0ce7bab13c99ba0565f426508a7cd8f4c247e5a")
     assert(row3["balance"] == "000000000000000000000000000000000000000000000005496419417a1f4000") # 0x5496419417a1f4000 => 97522100000000000000 (97.5321 - 0.0100)
 
@@ -550,7 +550,7 @@ try:
     Utils.Print("\tTest Account balance %s" % testAccActualAmount)
     if testAccActualAmount != expectedAmount:
         Utils.errorExit("Transfer verification failed. Excepted %s, actual: %s" % (expectedAmount, testAccActualAmount))
-    row3=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account", 3) # 3rd balance of this integration test
+    row3=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account2", 3) # 3rd balance of this integration test
     assert(row3["eth_address"] == "f0ce7bab13c99ba0565f426508a7cd8f4c247e5a")
     assert(row3["balance"] == "000000000000000000000000000000000000000000000005d407b55394464000") # 0x5d407b55394464000 => 107512100000000000000 (97.5321 + 10.000 - 0.0100 - 0.0100)
 
@@ -571,7 +571,7 @@ try:
     Utils.Print("\tTest Account balance %s" % testAccActualAmount)
     if testAccActualAmount != expectedAmount:
         Utils.errorExit("Transfer verification failed. Excepted %s, actual: %s" % (expectedAmount, testAccActualAmount))
-    row4=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account", 4) # 4th balance of this integration test
+    row4=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account2", 4) # 4th balance of this integration test
     assert(row4["eth_address"] == "9e126c57330fa71556628e0aabd6b6b6783d99fa")
     assert(row4["balance"] == "0000000000000000000000000000000000000000000000024c9d822e105f8000") # 0x24c9d822e105f8000 => 42414200000000000000 (42.4242 - 0.0100)
 
@@ -596,7 +596,7 @@ try:
     actData = {"miner":minerAcc.name, "rlptx":Web3.toHex(signed_trx.rawTransaction)[2:]}
     trans = prodNode.pushMessage(evmAcc.name, "pushtx", json.dumps(actData), '-p {0}'.format(minerAcc.name), silentErrors=True)
     prodNode.waitForTransBlockIfNeeded(trans[1], True)
-    row4=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account", 4) # 4th balance of this integration test
+    row4=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account2", 4) # 4th balance of this integration test
     Utils.Print("\taccount row4: ", row4)
     assert(row4["eth_address"] == "9e126c57330fa71556628e0aabd6b6b6783d99fa")
     assert(row4["balance"] == "000000000000000000000000000000000000000000000001966103689de22000") # 0x1966103689de22000 => 29282690000000000000 (42.4242 - 0.0100 - 13.1313 - 21000 * 10^10)
@@ -629,7 +629,7 @@ try:
     actData = {"miner":minerAcc.name, "rlptx":Web3.toHex(signed_trx.rawTransaction)[2:]}
     trans = prodNode.pushMessage(evmAcc.name, "pushtx", json.dumps(actData), '-p {0}'.format(minerAcc.name), silentErrors=True)
     prodNode.waitForTransBlockIfNeeded(trans[1], True)
-    row4=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account", 4) # 4th balance of this integration test
+    row4=prodNode.getTableRow(evmAcc.name, evmAcc.name, "account2", 4) # 4th balance of this integration test
     Utils.Print("\taccount row4: ", row4)
     assert(row4["eth_address"] == "9e126c57330fa71556628e0aabd6b6b6783d99fa")
     assert(row4["balance"] == "000000000000000000000000000000000000000000000001887f8db687170000") # 0x1887f8db687170000 => 28282480000000000000 (42.4242 - 0.0100 - 13.1313 - 1.0000 - 2 * 21000 * 10^10)
@@ -659,9 +659,10 @@ try:
 
     time.sleep(10) # allow time to sync trxs
 
-    # Validate all balances are the same on both sides
-    rows=prodNode.getTable(evmAcc.name, evmAcc.name, "account")
-    for row in rows['rows']:
+    # Validate all balances are the same on both sides, accounts not written since the compact layout are still in the legacy table
+    rows=prodNode.getTable(evmAcc.name, evmAcc.name, "account2")['rows'] + prodNode.getTable(evmAcc.name, evmAcc.name, "account")['rows']
+    assert len(rows) > 0, "no EVM accounts found"
+    for row in rows:
         Utils.Print("Checking 0x{0} balance".format(row['eth_address']))
         r = w3.eth.get_balance(Web3.toChecksumAddress('0x'+row['eth_address']))
         assert r == int(row['balance'],16), f"{row['eth_address']} {r} != {int(row['balance'],16)}"
@@ -0,0 +1,67 @@
+#!/bin/bash
+#
+# Compare the in-process MDBX read path (--chaindata) with the remote KV one (--target only) under a wrk load on
+# eth_getBalance, eth_call and eth_getLogs. Results are written as CSV to /tmp/<date_time>_wrk_db.csv.
+#
+# Usage: wrk_local_vs_remote_db.sh chaindataDir [silkrpcBuildDir] [duration] [connections] [contexts]
+#
+# The request parameters come from the environment: ADDRESS (account/contract), BLOCK (hex block number), CALL_DATA
+# (eth_call input), FROM_BLOCK and TO_BLOCK (eth_getLogs range).
+
+CHAINDATA=${1:?chaindata directory required}
+BUILD_DIR=${2:-../../build_gcc_release}
+DURATION=${3:-30}
+CONNECTIONS=${4:-64}
+NUM_CONTEXTS=${5:-4}
+TARGET=${TARGET:-localhost:8001}
+HTTP_PORT=${HTTP_PORT:-51515}
+ADDRESS=${ADDRESS:-0x0000000000000000000000000000000000000000}
+BLOCK=${BLOCK:-latest}
+CALL_DATA=${CALL_DATA:-0x}
+FROM_BLOCK=${FROM_BLOCK:-0x1}
+TO_BLOCK=${TO_BLOCK:-latest}
+
+declare -A REQUESTS=(
+    [eth_getBalance]="[\"$ADDRESS\",\"$BLOCK\"]"
+    [eth_call]="[{\"to\":\"$ADDRESS\",\"data\":\"$CALL_DATA\"},\"$BLOCK\"]"
+    [eth_getLogs]="[{\"fromBlock\":\"$FROM_BLOCK\",\"toBlock\":\"$TO_BLOCK\",\"address\":\"$ADDRESS\"}]"
+)
+
+RESULT_FILE=/tmp/$(date +%Y%m%d_%H%M%S)_wrk_db.csv
+LUA_SCRIPT=$(mktemp --suffix .lua)
+trap 'rm -f $LUA_SCRIPT' EXIT
+
+echo "database,method,requests,duration_us,requests_per_sec,latency_p50_ms,latency_p99_ms,errors" > $RESULT_FILE
+
+for DATABASE in remote local; do
+    if [ "$DATABASE" == "local" ]; then
+        DATABASE_ARGS="--chaindata $CHAINDATA"
+    else
+        DATABASE_ARGS=""
+    fi
+    $BUILD_DIR/cmd/silkrpcdaemon --target $TARGET --http_port localhost:$HTTP_PORT --num_contexts $NUM_CONTEXTS \
+        $DATABASE_ARGS > /dev/null 2>&1 &
+    DAEMON_PID=$!
+    sleep 2
+
+    for METHOD in eth_getBalance eth_call eth_getLogs; do
+        cat > $LUA_SCRIPT <<EOF
+wrk.method = "POST"
+wrk.headers["Content-Type"] = "application/json"
+wrk.body = '{"jsonrpc":"2.0","id":1,"method":"$METHOD","params":${REQUESTS[$METHOD]}}'
+
+done = function(summary, latency, requests)
+   io.write(string.format("%d,%d,%.2f,%.2f,%.2f,%d\n", summary.requests, summary.duration,
+      summary.requests / (summary.duration / 1e6), latency:percentile(50) / 1e3, latency:percentile(99) / 1e3,
+      summary.errors.status + summary.errors.timeout))
+end
+EOF
+        RESULT=$(wrk -t $NUM_CONTEXTS -c $CONNECTIONS -d ${DURATION}s -s $LUA_SCRIPT http://localhost:$HTTP_PORT | tail -n 1)
+        echo "$DATABASE,$METHOD,$RESULT" | tee -a $RESULT_FILE
+    done
+
+    kill $DAEMON_PID
+    wait $DAEMON_PID 2>/dev/null
+done
+
+echo "Results written to $RESULT_FILE"
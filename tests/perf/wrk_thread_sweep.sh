@@ -0,0 +1,49 @@
+#!/bin/bash
+#
+# Sweep the number of Silkrpc execution contexts under a wrk load, one daemon run per value, to check that the request
+# throughput scales with the cores serving HTTP. Results are appended as CSV to /tmp/<date_time>_wrk_sweep.csv.
+#
+# Usage: wrk_thread_sweep.sh [silkrpcBuildDir] [contexts] [duration] [connections] [method] [roundRobin]
+
+BUILD_DIR=${1:-../../build_gcc_release}
+CONTEXTS=${2:-"1 2 4 8"}
+DURATION=${3:-30}
+CONNECTIONS=${4:-256}
+METHOD=${5:-eth_blockNumber}
+ROUND_ROBIN=${6:-false}
+TARGET=${TARGET:-localhost:9090}
+HTTP_PORT=${HTTP_PORT:-51515}
+
+RESULT_FILE=/tmp/$(date +%Y%m%d_%H%M%S)_wrk_sweep.csv
+LUA_SCRIPT=$(mktemp --suffix .lua)
+trap 'rm -f $LUA_SCRIPT' EXIT
+
+cat > $LUA_SCRIPT <<EOF
+wrk.method = "POST"
+wrk.headers["Content-Type"] = "application/json"
+wrk.body = '{"jsonrpc":"2.0","id":1,"method":"$METHOD","params":[]}'
+
+done = function(summary, latency, requests)
+   io.write(string.format("%d,%d,%.2f,%.2f,%.2f,%d\n", summary.requests, summary.duration,
+      summary.requests / (summary.duration / 1e6), latency:percentile(50) / 1e3, latency:percentile(99) / 1e3,
+      summary.errors.status + summary.errors.timeout))
+end
+EOF
+
+echo "contexts,wrk_threads,requests,duration_us,requests_per_sec,latency_p50_ms,latency_p99_ms,errors" > $RESULT_FILE
+
+for NUM_CONTEXTS in $CONTEXTS; do
+    $BUILD_DIR/cmd/silkrpcdaemon --target $TARGET --http_port localhost:$HTTP_PORT --num_contexts $NUM_CONTEXTS \
+        --http_round_robin=$ROUND_ROBIN > /dev/null 2>&1 &
+    DAEMON_PID=$!
+    sleep 2
+
+    # As many load threads as daemon contexts, so that the client is not the bottleneck
+    RESULT=$(wrk -t $NUM_CONTEXTS -c $CONNECTIONS -d ${DURATION}s -s $LUA_SCRIPT http://localhost:$HTTP_PORT | tail -n 1)
+    echo "$NUM_CONTEXTS,$NUM_CONTEXTS,$RESULT" | tee -a $RESULT_FILE
+
+    kill $DAEMON_PID
+    wait $DAEMON_PID 2>/dev/null
+done
+
+echo "Results written to $RESULT_FILE"